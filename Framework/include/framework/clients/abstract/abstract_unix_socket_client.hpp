@@ -6,9 +6,9 @@
 #include <yaml-cpp/yaml.h>
 
 #include <atomic>
+#include <deque>
 #include <future>
 #include <mutex>
-#include <queue>
 #include <regex>
 #include <unordered_map>
 
@@ -126,13 +126,28 @@ struct convert<UnixCommunicationMessage> {
 };
 }  // namespace YAML
 
+/**
+ * @brief Client of a unix socket that speaks UnixCommunicationMessage, with requests and events.
+ *
+ * Requests get an increasing id and are written by the calling thread without blocking. When the socket is
+ * full, the frames wait in a lock free queue that a background thread writes once there is room again, so
+ * any number of requests can be outstanding. Responses are matched by id on the read thread, which also
+ * notices when the server goes away.
+ */
 class AbstractUnixSocketClient : Loggable {
   public:
 	void emitUnixSocketEvent(EventBus& eventBus, const std::string& name, const std::string& event, CallbackParam value);
 
 	void onUnixSocketEvent(EventBus& eventBus, const std::string& name, const std::string& event, CallbackWithParams&& callback);
 
-	AbstractUnixSocketClient(const std::string& path, const std::string& name);
+	/**
+	 * @brief Starts connecting to a socket in the background.
+	 *
+	 * @param path Socket file.
+	 * @param name Client name, used for logging and events.
+	 * @param binary If true, requests are sent with UnixMessageCodec instead of YAML. Replies are read in either encoding.
+	 */
+	AbstractUnixSocketClient(const std::string& path, const std::string& name, bool binary = false);
 
 	~AbstractUnixSocketClient();
 
@@ -142,6 +157,21 @@ class AbstractUnixSocketClient : Loggable {
 
 	bool connected();
 
+	/**
+	 * @brief Sends a single request on a connection of its own and waits for the response.
+	 *
+	 * Meant for short lived processes, nothing runs in the background and the request is binary encoded.
+	 *
+	 * @param path Socket file.
+	 * @param method Method name.
+	 * @param data Method parameters.
+	 * @param timeout_ms Time for the whole call, connection included.
+	 * @return Response data.
+	 * @throws std::runtime_error if the server can't be reached, doesn't answer in time or answers with an error.
+	 */
+	static std::vector<std::any> invokeOnce(const std::string& path, const std::string& method, const std::vector<std::any>& data,
+											int timeout_ms = 1000);
+
   protected:
 	std::vector<std::any> invoke(const std::string& method, const std::vector<std::any>& data, int timeout_ms = 3000);
 
@@ -150,28 +180,51 @@ class AbstractUnixSocketClient : Loggable {
 	void on_with_params(const std::string& evName, CallbackWithParams&& callback);
 
   private:
+	struct Outgoing {
+		std::string frame;
+		Outgoing* next;
+	};
+
 	void connectionLoop();
 
 	void writeLoop();
 
 	void readLoop();
 
+	void send(std::string&& payload);
+
+	bool flushPending();
+
+	bool writeBacklog();
+
+	void closeSocket();
+
 	void handleResponse(const UnixCommunicationMessage& msg);
 
 	void handleEvent(const UnixCommunicationMessage& msg);
 
-	void stop(bool stopConnThread = true);
+	void disconnect();
+
+	void stop();
 
 	std::string path;
 	std::string name;
-	int sock;
-	std::queue<std::string> _message_queue;
-	std::unordered_map<std::string, std::promise<UnixMethodResponse>> promises;
+	bool binary;
+	int sock = -1;
+
+	std::atomic<uint32_t> nextId{0};
+	std::unordered_map<uint32_t, std::promise<UnixMethodResponse>> promises;
+
+	// Frames are pushed by any thread, and written in order by whoever holds the writing flag
+	std::atomic<Outgoing*> outgoing{nullptr};
+	std::atomic_flag writing = ATOMIC_FLAG_INIT;
+	std::atomic<bool> blocked{false};
+	std::deque<std::string> backlog;
+	size_t backlogOffset = 0;
 
 	std::atomic<bool> _running;
 	std::atomic<bool> _connected;
 	std::mutex mutex;
-	std::condition_variable queue_cv;
 
 	std::thread connectionThread;
 	std::thread writeThread;
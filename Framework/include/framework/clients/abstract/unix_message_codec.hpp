@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+
+#include "framework/clients/abstract/abstract_unix_socket_client.hpp"
+
+/**
+ * @brief Binary encoding of UnixCommunicationMessage, an alternative to YAML for the socket messages.
+ *
+ * Payloads start with MAGIC, which can't start a YAML document, so both encodings can share a socket. The
+ * header holds the type, the flags and the number of data fields, followed by the name, the id, the error if
+ * any, and the data fields, each one tagged with its type. Numbers are big endian and strings are prefixed
+ * with their length. Data types are kept as sent, so an int is decoded as an int and a string as a string.
+ */
+class UnixMessageCodec {
+  public:
+	inline static const char MAGIC[] = {'\0', 'R', 'P', 'B'};
+
+	/**
+	 * @brief Encodes a message. Data of types without a tag is sent as "<unsupported>", as YAML does.
+	 *
+	 * @param msg Message to encode.
+	 * @return Encoded payload, without the length prefix.
+	 */
+	static std::string encode(const UnixCommunicationMessage& msg);
+
+	/**
+	 * @brief Checks whether a payload uses this encoding.
+	 *
+	 * @param payload Payload, without the length prefix.
+	 * @return true if binary, false if it should be parsed as YAML.
+	 */
+	static bool isBinary(const std::string& payload);
+
+	/**
+	 * @brief Decodes a payload.
+	 *
+	 * @param payload Payload, without the length prefix.
+	 * @return Decoded message.
+	 * @throws std::runtime_error if the payload is truncated or malformed.
+	 */
+	static UnixCommunicationMessage decode(const std::string& payload);
+};
@@ -1,35 +1,82 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
 #include "framework/abstracts/loggable.hpp"
 #include "framework/abstracts/singleton.hpp"
 #include "framework/utils/file_utils.hpp"
 #include "framework/utils/yaml_utils.hpp"
 
+/**
+ * @brief Holds the configuration as immutable snapshots.
+ *
+ * Readers take the current snapshot without locking and keep a consistent view for as long as they hold it.
+ * Writers go through update(), which publishes a modified copy and schedules it to be saved.
+ */
 template <typename T>
 class Configuration : public Singleton<Configuration<T>>, Loggable {
   public:
+	inline static const std::chrono::milliseconds FLUSH_DELAY = std::chrono::milliseconds(500);
+
 	/**
-	 * @brief Saves the current configuration to persistent storage.
-	 *
-	 * This method serializes and writes the current configuration settings
-	 * to a file or other persistent medium, ensuring that changes are retained
-	 * across application restarts.
+	 * @brief Marks the current configuration to be saved to persistent storage.
 	 *
-	 * @note Throws an exception if saving fails.
+	 * The snapshot is written by a background flusher once FLUSH_DELAY has passed since the first unsaved
+	 * change, so a burst of changes costs a single write. The file is replaced atomically.
 	 */
 	void saveConfig() {
-		if (!config.has_value()) {
+		auto snapshot = config.load();
+		if (!snapshot) {
 			return;
 		}
 
-		logger->debug("Configuration saved");
+		{
+			std::lock_guard<std::mutex> lock(flushMutex);
+			pending = Snapshot{++version, snapshot};
+		}
+		flushCv.notify_one();
+	}
 
-		try {
-			YamlUtils::writeYamlFile(*config, configFile);
-		} catch (const std::exception& e) {
-			logger->error("Error saving settings file: {}", e.what());
+	/**
+	 * @brief Applies a change to a copy of the configuration, publishes it and schedules it to be saved.
+	 *
+	 * Updates are serialized, so concurrent changes are never lost. Readers still holding the previous
+	 * snapshot are not affected.
+	 *
+	 * @param mutator Function that modifies the new version.
+	 */
+	void update(const std::function<void(T&)>& mutator) {
+		{
+			std::lock_guard<std::mutex> lock(updateMutex);
+			auto next = std::make_shared<T>(*config.load());
+			mutator(*next);
+			config.store(std::move(next));
 		}
+		saveConfig();
 	}
+
+	/**
+	 * @brief Writes the pending changes, if any, before returning.
+	 */
+	void flush() {
+		std::optional<Snapshot> snapshot;
+		{
+			std::lock_guard<std::mutex> lock(flushMutex);
+			snapshot.swap(pending);
+		}
+		if (snapshot.has_value()) {
+			write(*snapshot);
+		}
+	}
+
 	/**
 	 * @brief Loads the configuration settings from the appropriate source.
 	 *
@@ -42,11 +89,13 @@ class Configuration : public Singleton<Configuration<T>>, Loggable {
 	 *       cannot be loaded.
 	 */
 	void loadConfig() {
+		std::lock_guard<std::mutex> lock(updateMutex);
 		if (FileUtils::exists(configFile)) {
 			logger->debug("Loading settings from {}", configFile);
 			try {
-				config = YamlUtils::readYamlFile<T>(configFile);
-				LoggerProvider::setConfigMap(config->logger);
+				auto loaded = std::make_shared<T>(YamlUtils::readYamlFile<T>(configFile));
+				LoggerProvider::setConfigMap(loaded->logger);
+				config.store(loaded);
 			} catch (const std::exception& e) {
 				logger->error("Error loading settings: {}", e.what());
 				logger->error("Creating new config file");
@@ -58,31 +107,104 @@ class Configuration : public Singleton<Configuration<T>>, Loggable {
 			logger->debug("Settings file not found, creating new");
 			FileUtils::createDirectory(configDir);
 
-			T defaultCfg;
-			config = defaultCfg;
+			config.store(std::make_shared<T>());
 
 			saveConfig();
+			flush();
 		}
 		logger->info("Configuration loaded");
 	}
 
 	/**
-	 * @brief Retrieves the current root configuration.
+	 * @brief Retrieves the current configuration snapshot.
 	 *
-	 * @return Reference to the RootConfig object containing the application's configuration settings.
+	 * @return Immutable snapshot, it never changes while held.
 	 */
-	T& getConfiguration() {
-		return config.value();
+	std::shared_ptr<const T> getConfiguration() const {
+		return config.load();
 	}
 
   protected:
 	Configuration(const std::string& dir, const std::string& file) : Loggable("Configuration"), configDir(dir), configFile(dir + "/" + file) {
 		loadConfig();
+		flusher = std::thread(&Configuration::flushLoop, this);
+	}
+
+  public:
+	~Configuration() {
+		{
+			std::lock_guard<std::mutex> lock(flushMutex);
+			stopping = true;
+		}
+		flushCv.notify_one();
+		if (flusher.joinable()) {
+			flusher.join();
+		}
+		flush();
 	}
 
   private:
 	friend class Singleton<Configuration<T>>;
+
+	struct Snapshot {
+		uint64_t version;
+		std::shared_ptr<const T> config;
+	};
+
 	std::string configDir;
 	std::string configFile;
-	std::optional<T> config = std::nullopt;
+	std::atomic<std::shared_ptr<const T>> config;
+	std::mutex updateMutex;
+
+	std::mutex flushMutex;
+	std::condition_variable flushCv;
+	std::optional<Snapshot> pending = std::nullopt;
+	uint64_t version				= 0;
+	bool stopping					= false;
+	std::thread flusher;
+
+	std::mutex writeMutex;
+	uint64_t written = 0;
+
+	void flushLoop() {
+		std::unique_lock<std::mutex> lock(flushMutex);
+		while (true) {
+			flushCv.wait(lock, [this] {
+				return stopping || pending.has_value();
+			});
+			// Later changes inside the window replace the pending copy
+			flushCv.wait_for(lock, FLUSH_DELAY, [this] {
+				return stopping;
+			});
+			if (stopping) {
+				return;
+			}
+			// An explicit flush inside the window already took it
+			if (!pending.has_value()) {
+				continue;
+			}
+
+			auto snapshot = std::move(pending);
+			pending.reset();
+			lock.unlock();
+			write(*snapshot);
+			lock.lock();
+		}
+	}
+
+	void write(const Snapshot& snapshot) {
+		std::lock_guard<std::mutex> lock(writeMutex);
+		// An explicit flush may already have written something newer
+		if (snapshot.version <= written) {
+			return;
+		}
+
+		try {
+			FileUtils::replaceFileContent(configFile, YamlUtils::writeYaml(*snapshot.config));
+			written = snapshot.version;
+			logger->debug("Configuration saved");
+		} catch (const std::exception& e) {
+			logger->error("Error saving settings file: {}", e.what());
+		}
+	}
 };
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief How a payload is handed to listeners: small trivial values by copy, anything else by const reference.
+ */
+template <typename T>
+using EventArg = std::conditional_t<std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*) * 2, T, const T&>;
+
+/**
+ * @brief Typed event with its own listener list.
+ *
+ * Listeners are kept in an immutable list that is replaced on every subscription, so emitting only takes
+ * a reference to the current list: it never locks, copies the listeners or allocates.
+ *
+ * @tparam Args Types of the event payload.
+ */
+template <typename... Args>
+class EventChannel {
+  public:
+	using Listener = std::function<void(EventArg<Args>...)>;
+
+	EventChannel() : listeners(std::make_shared<const std::vector<Listener>>()) {
+	}
+
+	EventChannel(const EventChannel&)			 = delete;
+	EventChannel& operator=(const EventChannel&) = delete;
+
+	/**
+	 * @brief Registers a listener.
+	 *
+	 * @param listener Function to invoke on every emit.
+	 */
+	void on(Listener&& listener) {
+		std::lock_guard<std::mutex> lock(mtx);
+		auto next = std::make_shared<std::vector<Listener>>(*listeners.load(std::memory_order_acquire));
+		next->push_back(std::move(listener));
+		listeners.store(std::move(next), std::memory_order_release);
+	}
+
+	/**
+	 * @brief Invokes every listener registered so far.
+	 *
+	 * A listener that throws doesn't stop the rest, the first exception is rethrown once all of them ran.
+	 *
+	 * @param args Event payload.
+	 */
+	void emit(EventArg<Args>... args) const {
+		std::exception_ptr error;
+		auto current = listeners.load(std::memory_order_acquire);
+		for (auto& listener : *current) {
+			try {
+				listener(args...);
+			} catch (...) {
+				if (!error) {
+					error = std::current_exception();
+				}
+			}
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+  private:
+	std::atomic<std::shared_ptr<const std::vector<Listener>>> listeners;
+	std::mutex mtx;
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "framework/abstracts/loggable.hpp"
+#include "framework/abstracts/singleton.hpp"
+#include "framework/tracing/tracer.hpp"
+
+enum class EventPriority : int { LOW, NORMAL, HIGH };
+
+/**
+ * @brief Worker pool a topic runs on, tasks of one lane never wait for the workers of another.
+ */
+enum class EventLane : int { EVENTS, REQUESTS };
+
+/**
+ * @brief Runs event handlers on small worker pools instead of the thread that emitted the event.
+ *
+ * Tasks are grouped by topic. Tasks of the same topic run one at a time and in the order they were submitted,
+ * tasks of different topics may run in parallel, highest priority first. A coalescing submission replaces the
+ * task of its topic that is still waiting, so a burst of events is handled once with the latest state.
+ */
+class EventExecutor : public Singleton<EventExecutor>, Loggable {
+  public:
+	using TopicId = size_t;
+
+	inline static const size_t LANES		= 2;
+	inline static const size_t WORKERS		= 2;
+	inline static const double SLOW_TASK_MS = 500;
+
+	struct TopicStats {
+		uint64_t handled   = 0;
+		uint64_t coalesced = 0;
+		uint64_t failed	   = 0;
+		double waitMs	   = 0;
+		double maxWaitMs   = 0;
+		double runMs	   = 0;
+		double maxRunMs	   = 0;
+	};
+
+	struct Stats {
+		size_t queueDepth	 = 0;
+		size_t maxQueueDepth = 0;
+		std::map<std::string, TopicStats> topics;
+	};
+
+	~EventExecutor();
+
+	/**
+	 * @brief Gets the id of a topic, registering it the first time.
+	 *
+	 * @param name Name of the topic, used in logs and metrics.
+	 * @param lane Worker pool that runs the tasks of the topic, kept from the first registration.
+	 * @return Id to submit the tasks of the topic with.
+	 */
+	TopicId registerTopic(const std::string& name, EventLane lane = EventLane::EVENTS);
+
+	/**
+	 * @brief Queues a task.
+	 *
+	 * @param topic Id of the topic the task handles.
+	 * @param priority Priority among the queued tasks of every topic of its lane.
+	 * @param coalesce If true, replaces the waiting task of the same topic instead of queueing a new one.
+	 * @param task Function to run, exceptions thrown by it are logged.
+	 */
+	void submit(TopicId topic, EventPriority priority, bool coalesce, std::function<void()>&& task);
+
+	/**
+	 * @brief Gets the queue and handler metrics.
+	 *
+	 * @return A copy of the metrics.
+	 */
+	Stats getStats();
+
+	/**
+	 * @brief Drops the waiting tasks, waits for the running ones and logs the metrics. Later submissions are ignored.
+	 */
+	void stop();
+
+  private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Task {
+		EventPriority priority;
+		Clock::time_point queued;
+		uint64_t flowId;
+		std::function<void()> run;
+	};
+
+	struct Topic {
+		std::string name;
+		EventLane lane;
+		std::deque<Task> tasks;
+		// Coalesced submissions are written in place, it runs after the queued tasks
+		Task latest;
+		bool hasLatest = false;
+		bool running   = false;
+		TopicStats stats;
+	};
+
+	friend class Singleton<EventExecutor>;
+	EventExecutor();
+
+	std::mutex mtx;
+	std::array<std::condition_variable, LANES> cvs;
+	std::deque<Topic> topics;
+	std::unordered_map<std::string, TopicId> topicIds;
+	std::vector<std::thread> workers;
+	Tracer& tracer		 = Tracer::getInstance();
+	bool running		 = true;
+	size_t queueDepth	 = 0;
+	size_t maxQueueDepth = 0;
+
+	void workerLoop(EventLane lane);
+	size_t halt();
+	Topic* nextTopic(EventLane lane);
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Archives log files into the old directory and compresses them in the background.
+ *
+ * Archives are gzipped by a low priority thread, and the oldest ones are removed once all archives of the log
+ * take more than MAX_ARCHIVE_BYTES.
+ */
+class LogRotator {
+  public:
+	inline static const uintmax_t MAX_ARCHIVE_BYTES = 64 * 1024 * 1024;
+
+	/**
+	 * @brief Construct a new Log Rotator object
+	 *
+	 * @param fileName Log name, without extension.
+	 * @param logDir Directory of the live log.
+	 */
+	LogRotator(const std::string& fileName, const std::filesystem::path& logDir);
+
+	/**
+	 * @brief Stops the compression thread, an archive being compressed is left as it was.
+	 */
+	~LogRotator();
+
+	LogRotator(const LogRotator&)			 = delete;
+	LogRotator& operator=(const LogRotator&) = delete;
+
+	/**
+	 * @brief Archives the log of a previous run, and queues archives that were never compressed.
+	 */
+	void archivePrevious();
+
+	/**
+	 * @brief Moves a log into the old directory.
+	 *
+	 * The rename is atomic, a descriptor still open on the log keeps writing into the archive.
+	 *
+	 * @param file Log to archive.
+	 * @return Path of the archive.
+	 */
+	std::filesystem::path archive(const std::filesystem::path& file);
+
+	/**
+	 * @brief Queues the compression of an archive, once nothing writes into it anymore.
+	 *
+	 * @param file Archive to compress.
+	 */
+	void enqueue(const std::filesystem::path& file);
+
+  private:
+	std::string fileName;
+	std::filesystem::path logDir;
+	std::filesystem::path oldDir;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::deque<std::filesystem::path> pending;
+	std::atomic<bool> stop{false};
+	std::thread runner;
+
+	void compressLoop();
+	void compress(const std::filesystem::path& file);
+	void prune();
+	static std::string stamp(std::filesystem::file_time_type time);
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "framework/logger/sink/console_sink.hpp"
+#include "framework/logger/sink/file_sink.hpp"
+#include "framework/models/logger_level.hpp"
+
+/**
+ * @brief Writes log lines to the sinks from a background thread.
+ *
+ * Every producer thread owns a ring of lines, so logging only takes a sequence number and never waits on other
+ * threads. The writer drains all rings at once, restores the global order and issues a single write per sink
+ * for the whole batch. Pending lines are also written out when the process gets a fatal signal.
+ */
+class LogWriter {
+  public:
+	inline static const size_t RING_SLOTS = 512;
+	inline static const size_t MAX_RINGS  = 64;
+
+	/**
+	 * @brief Starts the writer thread.
+	 *
+	 * @param consoleSink Console output.
+	 * @param fileSink Optional file output.
+	 */
+	LogWriter(std::shared_ptr<ConsoleSink> consoleSink, std::optional<std::shared_ptr<FileSink>> fileSink);
+
+	/**
+	 * @brief Stops the writer thread after writing every pending line.
+	 */
+	~LogWriter();
+
+	LogWriter(const LogWriter&)			   = delete;
+	LogWriter& operator=(const LogWriter&) = delete;
+
+	/**
+	 * @brief Queues a formatted line.
+	 *
+	 * Threads that couldn't get a ring write the line themselves.
+	 *
+	 * @param level Level of the line.
+	 * @param line Formatted line, ending with a new line.
+	 */
+	void push(LoggerLevel level, std::string&& line);
+
+	/**
+	 * @brief Writes every pending line before returning.
+	 *
+	 * Must be called before replacing or ending the process without running destructors (exec, _exit).
+	 */
+	void flush();
+
+  private:
+	struct Record {
+		uint64_t sequence;
+		LoggerLevel level;
+		std::string line;
+	};
+
+	struct Ring {
+		std::atomic<bool> owned{false};
+		std::atomic<size_t> head{0};
+		std::atomic<size_t> tail{0};
+		std::array<Record, RING_SLOTS> slots;
+	};
+
+	struct ThreadRing;
+
+	inline static std::atomic<uint64_t> generations{0};
+	inline static std::atomic<LogWriter*> active{nullptr};
+
+	uint64_t id;
+	std::shared_ptr<ConsoleSink> consoleSink;
+	std::optional<std::shared_ptr<FileSink>> fileSink;
+
+	std::atomic<uint64_t> sequence{0};
+	std::atomic<bool> pending{false};
+	std::atomic<bool> running{true};
+	std::atomic_flag draining = ATOMIC_FLAG_INIT;
+
+	std::mutex registryMutex;
+	std::array<std::shared_ptr<Ring>, MAX_RINGS> rings;
+	std::atomic<size_t> ringCount{0};
+
+	std::vector<Record> batch;
+	std::string consoleBuffer;
+	std::string fileBuffer;
+	std::thread runner;
+
+	void writerLoop();
+	void wake();
+	Ring* ringForThread();
+	std::shared_ptr<Ring> claimRing();
+
+	void lockDrain();
+	void unlockDrain();
+	void collect();
+	void writeBatch();
+	void emergencyFlush();
+
+	static void installSignalHandlers();
+	static void onFatalSignal(int signal);
+	static void onFork();
+};
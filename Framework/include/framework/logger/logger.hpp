@@ -8,12 +8,12 @@
  */
 #pragma once
 
+#include <atomic>
+#include <format>
 #include <memory>
-#include <mutex>
-#include <optional>
+#include <string>
 
-#include "framework/logger/sink/console_sink.hpp"
-#include "framework/logger/sink/file_sink.hpp"
+#include "framework/logger/log_writer.hpp"
 #include "framework/models/logger_level.hpp"
 
 template <typename... Args>
@@ -35,12 +35,21 @@ class Logger {
 	 */
 	void setLevel(LoggerLevel level);
 
+	/**
+	 * @brief Checks whether lines of a level are written, before paying for their formatting.
+	 *
+	 * @param level
+	 * @return true if enabled, false otherwise.
+	 */
+	bool isEnabled(LoggerLevel level) const;
+
 	/**
 	 * @brief Construct a new Logger object
 	 *
+	 * @param writer
 	 * @param name
 	 */
-	Logger(std::shared_ptr<ConsoleSink> console_sink, std::optional<std::shared_ptr<FileSink>> fileSink, std::string name);
+	Logger(std::shared_ptr<LogWriter> writer, std::string name);
 
 	/**
 	 * @brief  Send debug log line
@@ -60,7 +69,9 @@ class Logger {
 	 */
 	template <typename... Args>
 	void debug(const format_string_t<Args...>& message, Args&&... args) {
-		debug(std::format(message, std::forward<Args>(args)...));
+		if (isEnabled(LoggerLevel::DEBUG)) {
+			log(LoggerLevel::DEBUG, std::format(message, std::forward<Args>(args)...));
+		}
 	}
 
 	/**
@@ -81,7 +92,9 @@ class Logger {
 	 */
 	template <typename... Args>
 	void info(const format_string_t<Args...>& message, Args&&... args) {
-		info(std::format(message, std::forward<Args>(args)...));
+		if (isEnabled(LoggerLevel::INFO)) {
+			log(LoggerLevel::INFO, std::format(message, std::forward<Args>(args)...));
+		}
 	}
 
 	/**
@@ -102,7 +115,9 @@ class Logger {
 	 */
 	template <typename... Args>
 	void warn(const format_string_t<Args...>& message, Args&&... args) {
-		warn(std::format(message, std::forward<Args>(args)...));
+		if (isEnabled(LoggerLevel::WARN)) {
+			log(LoggerLevel::WARN, std::format(message, std::forward<Args>(args)...));
+		}
 	}
 
 	/**
@@ -123,7 +138,9 @@ class Logger {
 	 */
 	template <typename... Args>
 	void error(const format_string_t<Args...>& message, Args&&... args) {
-		error(std::format(message, std::forward<Args>(args)...));
+		if (isEnabled(LoggerLevel::ERROR)) {
+			log(LoggerLevel::ERROR, std::format(message, std::forward<Args>(args)...));
+		}
 	}
 
 	/**
@@ -144,7 +161,9 @@ class Logger {
 	 */
 	template <typename... Args>
 	void critical(const format_string_t<Args...>& message, Args&&... args) {
-		critical(std::format(message, std::forward<Args>(args)...));
+		if (isEnabled(LoggerLevel::CRITICAL)) {
+			log(LoggerLevel::CRITICAL, std::format(message, std::forward<Args>(args)...));
+		}
 	}
 
 	static void add_tab();
@@ -152,14 +171,12 @@ class Logger {
 	static void rem_tab();
 
   private:
-	inline static int tabs = 0;
-	inline static std::mutex mutex;
+	inline static std::atomic<int> tabs = 0;
 
-	std::shared_ptr<ConsoleSink> consoleSink;
-	std::optional<std::shared_ptr<FileSink>> fileSink;
+	std::shared_ptr<LogWriter> writer;
 	std::string name;
-	LoggerLevel level = LoggerLevel::INFO;
+	std::atomic<LoggerLevel> level = LoggerLevel::INFO;
 
-	static std::string now_timestamp();
+	static void append_timestamp(std::string& out);
 	void log(LoggerLevel msgLevel, const std::string&);
 };
\ No newline at end of file
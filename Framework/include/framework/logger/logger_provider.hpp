@@ -15,9 +15,8 @@
 #include <string>
 #include <unordered_map>
 
+#include "framework/logger/log_writer.hpp"
 #include "framework/logger/logger.hpp"
-#include "framework/logger/sink/console_sink.hpp"
-#include "framework/logger/sink/file_sink.hpp"
 
 class LoggerProvider {
   public:
@@ -44,10 +43,16 @@ class LoggerProvider {
 	 */
 	static void setConfigMap(const std::map<std::string, LoggerLevel>& configMap);
 
+	/**
+	 * @brief Writes every pending log line before returning.
+	 *
+	 * Lines are written in the background, so this must be called before exec or _exit.
+	 */
+	static void flush();
+
   private:
 	inline static const std::string DEFAULT_LOGGER_NAME = "Default";
-	inline static std::shared_ptr<ConsoleSink> console_sink{};
-	inline static std::optional<std::shared_ptr<FileSink>> file_sink = std::nullopt;
+	inline static std::shared_ptr<LogWriter> writer{};
 	inline static std::unordered_map<std::string, std::shared_ptr<Logger>> loggers{};
 
 	inline static LoggerLevel defaultLevel = LoggerLevel::INFO;
@@ -8,5 +8,26 @@ class Sink {
   public:
 	virtual ~Sink() = default;
 
-	virtual void write(const std::string&, LoggerLevel level) = 0;
-};
\ No newline at end of file
+	/**
+	 * @brief Appends a line to a batch, decorated the way this sink shows it.
+	 *
+	 * @param batch Batch being built.
+	 * @param line Formatted log line, ending with a new line.
+	 * @param level Level of the line.
+	 */
+	virtual void append(std::string& batch, const std::string& line, LoggerLevel level) const;
+
+	/**
+	 * @brief Writes a whole batch into the descriptor.
+	 *
+	 * @param batch Lines to write.
+	 */
+	virtual void write(const std::string& batch);
+
+	/**
+	 * @brief Descriptor the sink writes into.
+	 *
+	 * @return The file descriptor.
+	 */
+	virtual int descriptor() const = 0;
+};
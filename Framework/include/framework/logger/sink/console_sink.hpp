@@ -7,5 +7,6 @@ class ConsoleSink : public Sink {
 	ConsoleSink()			= default;
 	~ConsoleSink() override = default;
 
-	void write(const std::string&, LoggerLevel level) override;
-};
\ No newline at end of file
+	void append(std::string& batch, const std::string& line, LoggerLevel level) const override;
+	int descriptor() const override;
+};
@@ -1,17 +1,38 @@
 #pragma once
 
-#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
 
+#include "framework/logger/log_rotator.hpp"
 #include "framework/logger/sink/base/sink.hpp"
 
 class FileSink : public Sink {
   public:
-	explicit FileSink(const std::string& filename);
+	inline static const uintmax_t MAX_FILE_BYTES			 = 16 * 1024 * 1024;
+	inline static const std::chrono::hours MAX_FILE_AGE = std::chrono::hours(24);
+
+	/**
+	 * @brief Construct a new File Sink object
+	 *
+	 * @param filename File to write into, truncated on open.
+	 * @param rotator Optional rotator, the file is rotated once it is too big or too old.
+	 */
+	explicit FileSink(const std::string& filename, std::shared_ptr<LogRotator> rotator = nullptr);
 	~FileSink() override;
 
-	void write(const std::string& message, LoggerLevel level) override;
+	void write(const std::string& batch) override;
+	int descriptor() const override;
 
   private:
-	std::ofstream file;
-};
\ No newline at end of file
+	std::string filename;
+	std::shared_ptr<LogRotator> rotator;
+	std::atomic<int> fd = -1;
+	uintmax_t written	= 0;
+	std::chrono::steady_clock::time_point opened;
+
+	void rotate();
+	static int openFile(const std::string& filename);
+};
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "framework/abstracts/singleton.hpp"
+
+/**
+ * @brief Records spans and instant events into per thread ring buffers and exports them as a Chrome/Perfetto
+ * JSON trace.
+ *
+ * Recording only touches the buffer of the calling thread, so threads never wait on each other. Names and
+ * categories are not copied and must be string literals or enum names, only the detail is copied.
+ *
+ * Recording is off unless the RCC_TRACE environment variable is set or setEnabled() is called. Buffers of
+ * finished threads are kept for the last MAX_EXITED_THREADS threads only.
+ */
+class Tracer : public Singleton<Tracer> {
+  public:
+	using Clock = std::chrono::steady_clock;
+
+	inline static const size_t EVENTS_PER_THREAD  = 16384;
+	inline static const size_t MAX_EXITED_THREADS = 8;
+
+	~Tracer();
+
+	/**
+	 * @brief Checks whether events are being recorded.
+	 *
+	 * @return true if recording, false otherwise.
+	 */
+	bool isEnabled() const;
+
+	/**
+	 * @brief Starts or stops recording. Already recorded events are kept.
+	 *
+	 * @param enabled true to record.
+	 */
+	void setEnabled(bool enabled);
+
+	/**
+	 * @brief Records a span that already finished.
+	 *
+	 * @param category Category of the span.
+	 * @param name Name of the span.
+	 * @param start Start of the span.
+	 * @param end End of the span.
+	 * @param detail Optional free text shown with the span.
+	 */
+	void complete(std::string_view category, std::string_view name, Clock::time_point start, Clock::time_point end,
+				  std::string&& detail = "");
+
+	/**
+	 * @brief Records an instant event.
+	 *
+	 * @param category Category of the event.
+	 * @param name Name of the event.
+	 * @param detail Optional free text shown with the event.
+	 */
+	void instant(std::string_view category, std::string_view name, std::string&& detail = "");
+
+	/**
+	 * @brief Gets an id to link work handed over to another thread.
+	 *
+	 * @return A new flow id.
+	 */
+	uint64_t nextFlowId();
+
+	/**
+	 * @brief Records the hand over point of a flow, inside the span that hands the work over.
+	 *
+	 * @param id Flow id.
+	 */
+	void flowStart(uint64_t id);
+
+	/**
+	 * @brief Records the pick up point of a flow, inside the span that runs the work.
+	 *
+	 * @param id Flow id.
+	 */
+	void flowEnd(uint64_t id);
+
+	/**
+	 * @brief Writes every recorded event to a JSON file that chrome://tracing and Perfetto can open.
+	 *
+	 * @param path Destination file.
+	 * @return Number of events written.
+	 */
+	size_t exportJson(const std::string& path);
+
+  private:
+	friend class Singleton<Tracer>;
+	Tracer();
+
+	struct Event {
+		char phase;
+		std::string_view category;
+		std::string_view name;
+		int64_t startNs;
+		int64_t durationNs;
+		uint64_t id;
+		std::string detail;
+	};
+
+	struct ThreadBuffer {
+		int tid;
+		std::string threadName;
+		std::mutex mutex;
+		std::vector<Event> events;
+		size_t next = 0;
+	};
+
+	struct ThreadHolder;
+
+	inline static std::atomic<bool> alive{false};
+
+	std::atomic<bool> enabled = false;
+	std::atomic<uint64_t> flowIds{0};
+	Clock::time_point epoch;
+	std::mutex registryMutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	std::deque<std::shared_ptr<ThreadBuffer>> exited;
+
+	void record(Event&& event);
+	ThreadBuffer& threadBuffer();
+	void retire(const std::shared_ptr<ThreadBuffer>& buffer);
+	int64_t sinceEpoch(Clock::time_point time) const;
+};
+
+/**
+ * @brief Records a span from its construction to its destruction.
+ */
+class TraceSpan {
+  public:
+	/**
+	 * @brief Starts the span.
+	 *
+	 * @param category Category of the span, must outlive the tracer.
+	 * @param name Name of the span, must outlive the tracer.
+	 * @param detail Optional free text shown with the span.
+	 */
+	TraceSpan(std::string_view category, std::string_view name, std::string&& detail = "");
+	~TraceSpan();
+
+	TraceSpan(const TraceSpan&)			   = delete;
+	TraceSpan& operator=(const TraceSpan&) = delete;
+
+  private:
+	Tracer& tracer;
+	bool active;
+	std::string_view category;
+	std::string_view name;
+	std::string detail;
+	Tracer::Clock::time_point start;
+};
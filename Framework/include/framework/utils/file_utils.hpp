@@ -40,6 +40,17 @@ class FileUtils {
 	 */
 	static void writeFileContent(const std::string& path, const std::string& content);
 
+	/**
+	 * @brief Replace file content atomically.
+	 *
+	 * Writes the content to a temporary file next to the target, syncs it and renames it over the target, so
+	 * readers see either the old or the new content even if the process dies halfway.
+	 *
+	 * @param path The file path.
+	 * @param content The content to write.
+	 */
+	static void replaceFileContent(const std::string& path, const std::string& content);
+
 	/**
 	 * @brief Read content from file.
 	 *
@@ -145,4 +156,14 @@ class FileUtils {
 
 	// Lista los elementos (nombres) de un directorio
 	static std::vector<std::string> listDirectory(const std::string& path);
+
+	/**
+	 * @brief Find every executable for a command in PATH.
+	 *
+	 * Same result as 'which -a', without starting a shell. A command with a slash is only checked itself.
+	 *
+	 * @param command The command name.
+	 * @return Paths of the executables, in PATH order.
+	 */
+	static std::vector<std::string> findInPath(const std::string& command);
 };
\ No newline at end of file
@@ -1,11 +1,29 @@
 #include "framework/clients/abstract/abstract_unix_socket_client.hpp"
 
+#include <poll.h>
+
+#include <charconv>
 #include <csignal>
+#include <cstring>
+#include <iterator>
+#include <utility>
 
-#include "framework/utils/string_utils.hpp"
+#include "framework/clients/abstract/unix_message_codec.hpp"
 #include "framework/utils/time_utils.hpp"
 #include "framework/utils/yaml_utils.hpp"
 
+namespace {
+struct SocketGuard {
+	int fd;
+
+	~SocketGuard() {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+};
+}  // namespace
+
 void AbstractUnixSocketClient::emitUnixSocketEvent(EventBus& eventBus, const std::string& name, const std::string& event, CallbackParam value) {
 	eventBus.emit_event("unix.socket." + name + ".event." + event, value);
 }
@@ -17,7 +35,8 @@ void AbstractUnixSocketClient::onUnixSocketEvent(EventBus& eventBus, const std::
 	});
 }
 
-AbstractUnixSocketClient::AbstractUnixSocketClient(const std::string& path, const std::string& name) : Loggable(name), path(path), name(name) {
+AbstractUnixSocketClient::AbstractUnixSocketClient(const std::string& path, const std::string& name, bool binary)
+	: Loggable(name), path(path), name(name), binary(binary) {
 	signal(SIGPIPE, SIG_IGN);
 
 	_running.store(true);
@@ -30,6 +49,11 @@ AbstractUnixSocketClient::AbstractUnixSocketClient(const std::string& path, cons
 
 AbstractUnixSocketClient::~AbstractUnixSocketClient() {
 	stop();
+
+	auto node = outgoing.exchange(nullptr);
+	while (node) {
+		delete std::exchange(node, node->next);
+	}
 }
 
 void AbstractUnixSocketClient::onConnect(Callback&& callback) {
@@ -45,9 +69,11 @@ bool AbstractUnixSocketClient::connected() {
 }
 
 std::vector<std::any> AbstractUnixSocketClient::invoke(const std::string& method, const std::vector<std::any>& data, int timeout_ms) {
+	auto id = nextId++;
+
 	UnixCommunicationMessage cm;
 	cm.type = "REQUEST";
-	cm.id	= StringUtils::generateUUIDv4();
+	cm.id	= std::to_string(id);
 	cm.name = method;
 	cm.data = data;
 
@@ -55,15 +81,16 @@ std::vector<std::any> AbstractUnixSocketClient::invoke(const std::string& method
 	std::future fut = prom.get_future();
 	{
 		std::lock_guard<std::mutex> lock(mutex);
-		promises[cm.id] = std::move(prom);
-		_message_queue.push(YamlUtils::writeYaml(cm));
+		promises[id] = std::move(prom);
 	}
-	queue_cv.notify_one();
+	send(binary ? UnixMessageCodec::encode(cm) : YamlUtils::writeYaml(cm));
 
 	if (fut.wait_for(std::chrono::milliseconds(timeout_ms)) == std::future_status::timeout) {
-		if (method != "ping") {
-			logger->error("No response for {} after {} ms", method, timeout_ms);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			promises.erase(id);
 		}
+		logger->error("No response for {} after {} ms", method, timeout_ms);
 		throw std::runtime_error("UnixSocketTimeoutError");
 	}
 
@@ -76,6 +103,71 @@ std::vector<std::any> AbstractUnixSocketClient::invoke(const std::string& method
 	return resp.data.data;
 }
 
+std::vector<std::any> AbstractUnixSocketClient::invokeOnce(const std::string& path, const std::string& method, const std::vector<std::any>& data,
+														   int timeout_ms) {
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+	UnixCommunicationMessage cm;
+	cm.type = "REQUEST";
+	cm.id	= "0";
+	cm.name = method;
+	cm.data = data;
+
+	auto payload	= UnixMessageCodec::encode(cm);
+	uint32_t msgLen = htonl(payload.size());
+	auto frame		= std::string(reinterpret_cast<const char*>(&msgLen), sizeof(msgLen)) + payload;
+
+	SocketGuard guard{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+	sockaddr_un addr{};
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+	if (guard.fd < 0 || connect(guard.fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+		throw std::runtime_error(std::string("UnixSocketConnectError: ") + strerror(errno));
+	}
+
+	for (size_t sent = 0; sent < frame.size();) {
+		auto n = ::send(guard.fd, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+		if (n < 0 && errno != EINTR) {
+			throw std::runtime_error(std::string("UnixSocketWriteError: ") + strerror(errno));
+		}
+		sent += std::max<ssize_t>(n, 0);
+	}
+
+	std::string buffer;
+	char chunk[4096];
+	while (true) {
+		if (buffer.size() >= sizeof(msgLen)) {
+			std::memcpy(&msgLen, buffer.data(), sizeof(msgLen));
+			msgLen = ntohl(msgLen);
+			if (buffer.size() - sizeof(msgLen) >= msgLen) {
+				break;
+			}
+		}
+
+		auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+		pollfd pfd{guard.fd, POLLIN, 0};
+		if (left <= 0 || poll(&pfd, 1, left) == 0) {
+			throw std::runtime_error("UnixSocketTimeoutError");
+		}
+
+		auto n = read(guard.fd, chunk, sizeof(chunk));
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			throw std::runtime_error("UnixSocketDisconnectedError");
+		}
+		buffer.append(chunk, n);
+	}
+
+	// The server answers in the encoding of the request
+	auto msg = UnixMessageCodec::decode(buffer.substr(sizeof(msgLen), msgLen));
+	if (msg.error.has_value()) {
+		throw std::runtime_error(*msg.error);
+	}
+	return msg.data;
+}
+
 void AbstractUnixSocketClient::on_without_params(const std::string& evName, Callback&& callback) {
 	on_with_params(evName, [callback = std::move(callback)](CallbackParam) {
 		callback();
@@ -88,12 +180,7 @@ void AbstractUnixSocketClient::on_with_params(const std::string& evName, Callbac
 
 void AbstractUnixSocketClient::connectionLoop() {
 	while (_running) {
-		if (_connected) {
-			TimeUtils::sleep(5000);
-			continue;
-		}
-
-		sock = socket(AF_UNIX, SOCK_STREAM, 0);
+		sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
 		sockaddr_un addr{};
 		addr.sun_family = AF_UNIX;
 		strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
@@ -116,108 +203,190 @@ void AbstractUnixSocketClient::connectionLoop() {
 			continue;
 		}
 
+		blocked = false;
 		emitUnixSocketEvent(eventBus, name, "connect", {});
 		_connected.store(true);
 
-		if (writeThread.joinable()) {
-			writeThread.join();
-		}
 		writeThread = std::thread([this] {
 			writeLoop();
 		});
-
-		if (readThread.joinable()) {
-			readThread.join();
-		}
 		readThread = std::thread([this] {
 			readLoop();
 		});
 
-		while (_connected) {
-			for (int i = 0; i < 50 && _connected && _running; i++) {
-				TimeUtils::sleep(100);
-			}
-			if (_connected && _running) {
-				try {
-					invoke("ping", {}, 1000);
-				} catch (std::exception& e) {
-					logger->debug("Lost connection");
-					stop(false);
-					_running = true;
-					emitUnixSocketEvent(eventBus, name, "disconnect", {});
-					TimeUtils::sleep(1000);
-					continue;
-				}
-			}
+		// Requests made while disconnected are sent now
+		if (!flushPending()) {
+			blocked = true;
+			blocked.notify_one();
 		}
+
+		// The read thread notices when the server goes away, no need to ping it
+		_connected.wait(true);
+		if (!_running) {
+			break;
+		}
+
+		readThread.join();
+		writeThread.join();
+		closeSocket();
+		TimeUtils::sleep(1000);
 	}
 }
 
-void AbstractUnixSocketClient::writeLoop() {
-	while (_running && _connected) {
-		std::unique_lock<std::mutex> lock(mutex);
-		queue_cv.wait(lock, [this] {
-			return !_message_queue.empty() || !_running;
-		});
+void AbstractUnixSocketClient::send(std::string&& payload) {
+	uint32_t msgLen = htonl(payload.size());
+	auto node		= new Outgoing{std::string(reinterpret_cast<const char*>(&msgLen), sizeof(msgLen)) + payload, nullptr};
 
-		if (!_running) {
-			break;
+	node->next = outgoing.load(std::memory_order_relaxed);
+	while (!outgoing.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+	}
+
+	if (!flushPending()) {
+		blocked = true;
+		blocked.notify_one();
+	}
+}
+
+bool AbstractUnixSocketClient::flushPending() {
+	while (true) {
+		if (writing.test_and_set(std::memory_order_acquire)) {
+			// The holder checks the queue again before leaving, the frame isn't forgotten
+			return true;
 		}
 
-		if (!_connected) {
-			lock.unlock();
-			TimeUtils::sleep(50);
-			continue;
+		// The socket is only replaced while holding the flag, frames wait for the next connection
+		bool written = !_connected || writeBacklog();
+		writing.clear(std::memory_order_release);
+		if (!written || !_connected || outgoing.load() == nullptr) {
+			return written;
 		}
+	}
+}
 
-		if (_message_queue.empty()) {
-			lock.unlock();
-			continue;
+bool AbstractUnixSocketClient::writeBacklog() {
+	// The queue is a stack, reversing it restores the order of the requests
+	auto node = outgoing.exchange(nullptr, std::memory_order_acquire);
+	std::deque<std::string> taken;
+	while (node) {
+		taken.push_front(std::move(node->frame));
+		delete std::exchange(node, node->next);
+	}
+	std::move(taken.begin(), taken.end(), std::back_inserter(backlog));
+
+	while (!backlog.empty()) {
+		auto& frame = backlog.front();
+		auto n		= ::send(sock, frame.data() + backlogOffset, frame.size() - backlogOffset, MSG_DONTWAIT | MSG_NOSIGNAL);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				return false;
+			}
+			// The read thread sees the broken connection, the requests time out
+			logger->error("Error sending message: {}", strerror(errno));
+			backlog.clear();
+			backlogOffset = 0;
+			return true;
+		}
+
+		backlogOffset += n;
+		if (backlogOffset == frame.size()) {
+			backlog.pop_front();
+			backlogOffset = 0;
+		}
+	}
+	return true;
+}
+
+void AbstractUnixSocketClient::closeSocket() {
+	while (writing.test_and_set(std::memory_order_acquire)) {
+		std::this_thread::yield();
+	}
+	if (sock != -1) {
+		close(sock);
+		sock = -1;
+	}
+	// Half a frame would corrupt the stream of the next connection
+	if (backlogOffset > 0) {
+		backlog.pop_front();
+		backlogOffset = 0;
+	}
+	writing.clear(std::memory_order_release);
+}
+
+void AbstractUnixSocketClient::writeLoop() {
+	while (true) {
+		blocked.wait(false);
+		if (!_running || !_connected) {
+			break;
 		}
 
-		std::string msg = _message_queue.front();
-		_message_queue.pop();
-		lock.unlock();
+		pollfd pfd{sock, POLLOUT, 0};
+		poll(&pfd, 1, 1000);
 
-		uint32_t msgLen = htonl(msg.size());
-		if (write(sock, &msgLen, sizeof(msgLen)) <= 0 || write(sock, msg.c_str(), msg.size()) <= 0) {
-			logger->error("Error sending message");
+		blocked = false;
+		if (!flushPending()) {
+			blocked = true;
 		}
 	}
 }
 
 void AbstractUnixSocketClient::readLoop() {
-	uint32_t resp_len;
+	std::string buffer;
+	char chunk[64 * 1024];
 	while (_running && _connected) {
-		ssize_t n = read(sock, &resp_len, sizeof(resp_len));
-		if (n == sizeof(resp_len)) {
+		ssize_t n = read(sock, chunk, sizeof(chunk));
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			bool lost = _running && _connected;
+			disconnect();
+			if (lost) {
+				logger->debug("Server closed the connection");
+				emitUnixSocketEvent(eventBus, name, "disconnect", {});
+			}
+			break;
+		}
+		buffer.append(chunk, n);
+
+		size_t offset = 0;
+		while (buffer.size() - offset >= sizeof(uint32_t)) {
+			uint32_t resp_len;
+			std::memcpy(&resp_len, buffer.data() + offset, sizeof(resp_len));
 			resp_len = ntohl(resp_len);
-			std::string data(resp_len, '\0');
-			size_t total_read = 0;
-			while (total_read < resp_len) {
-				ssize_t r = read(sock, &data[total_read], resp_len - total_read);
-				if (r <= 0) {
-					logger->debug("Server closed the connection");
-					emitUnixSocketEvent(eventBus, name, "disconnect", {});
-					_connected.store(false);
-					break;
-				}
-				total_read += r;
+			if (buffer.size() - offset - sizeof(resp_len) < resp_len) {
+				break;
 			}
 
-			auto j = YamlUtils::parseYaml<UnixCommunicationMessage>(data);
-			if (j.type == "RESPONSE") {
-				handleResponse(j);
-			} else if (j.type == "EVENT") {
-				handleEvent(j);
+			auto data = buffer.substr(offset + sizeof(resp_len), resp_len);
+			offset += sizeof(resp_len) + resp_len;
+			try {
+				auto j = UnixMessageCodec::isBinary(data) ? UnixMessageCodec::decode(data) : YamlUtils::parseYaml<UnixCommunicationMessage>(data);
+				if (j.type == "RESPONSE") {
+					handleResponse(j);
+				} else if (j.type == "EVENT") {
+					handleEvent(j);
+				}
+			} catch (const std::exception& e) {
+				logger->error("Error while parsing message: {}", e.what());
 			}
 		}
+		buffer.erase(0, offset);
 	}
 }
 
 void AbstractUnixSocketClient::handleResponse(const UnixCommunicationMessage& msg) {
+	uint32_t id;
+	auto [ptr, ec] = std::from_chars(msg.id.data(), msg.id.data() + msg.id.size(), id);
+	if (ec != std::errc() || ptr != msg.id.data() + msg.id.size()) {
+		logger->debug("Response with unknown id '{}'", msg.id);
+		return;
+	}
+
 	std::lock_guard<std::mutex> lock(mutex);
-	auto it = promises.find(msg.id);
+	auto it = promises.find(id);
 	if (it != promises.end()) {
 		UnixMethodResponse wsmr{msg, ""};
 		it->second.set_value(wsmr);
@@ -229,21 +398,31 @@ void AbstractUnixSocketClient::handleEvent(const UnixCommunicationMessage& msg)
 	emitUnixSocketEvent(eventBus, name, msg.name, msg.data);
 }
 
-void AbstractUnixSocketClient::stop(bool stopConnThread) {
-	try {
-		Logger::add_tab();
-		_connected = false;
-		_running   = false;
+void AbstractUnixSocketClient::disconnect() {
+	_connected = false;
+	_connected.notify_all();
 
-		if (sock != -1) {
-			shutdown(sock, SHUT_RDWR);
-			close(sock);
-			sock = -1;
-		}
+	if (sock != -1) {
+		shutdown(sock, SHUT_RDWR);
+	}
+	blocked = true;
+	blocked.notify_all();
 
-		queue_cv.notify_all();
+	// Requests still waiting would only time out
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& [id, prom] : promises) {
+		prom.set_value(UnixMethodResponse{{}, "UnixSocketDisconnectedError"});
+	}
+	promises.clear();
+}
+
+void AbstractUnixSocketClient::stop() {
+	try {
+		Logger::add_tab();
+		_running = false;
+		disconnect();
 
-		if (stopConnThread && connectionThread.joinable()) {
+		if (connectionThread.joinable()) {
 			connectionThread.join();
 		}
 		if (writeThread.joinable()) {
@@ -252,8 +431,9 @@ void AbstractUnixSocketClient::stop(bool stopConnThread) {
 		if (readThread.joinable()) {
 			readThread.join();
 		}
+		closeSocket();
 		Logger::rem_tab();
 	} catch (std::exception& e) {
 		logger->error("Error on stop: {}", e.what());
 	}
-}
+}
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include "framework/clients/abstract/unix_message_codec.hpp"
+
+#include <endian.h>
+
+#include <any>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+enum class MessageType : uint8_t { REQUEST, RESPONSE, EVENT };
+enum class FieldTag : uint8_t { STRING, BOOL, INT32, UINT32, INT64, UINT64, DOUBLE };
+
+const uint8_t FLAG_ERROR  = 0x01;
+const size_t HEADER_BYTES = sizeof(UnixMessageCodec::MAGIC) + 4;
+
+class Writer {
+  public:
+	std::string out;
+
+	void u8(uint8_t value) {
+		out.push_back(static_cast<char>(value));
+	}
+
+	void u16(uint16_t value) {
+		value = htobe16(value);
+		out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	void u32(uint32_t value) {
+		value = htobe32(value);
+		out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	void u64(uint64_t value) {
+		value = htobe64(value);
+		out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	void str(const std::string& value) {
+		u32(value.size());
+		out.append(value);
+	}
+};
+
+class Reader {
+  public:
+	explicit Reader(const std::string& in) : in(in) {
+	}
+
+	uint8_t u8() {
+		return static_cast<uint8_t>(*take(1));
+	}
+
+	uint16_t u16() {
+		uint16_t value;
+		std::memcpy(&value, take(sizeof(value)), sizeof(value));
+		return be16toh(value);
+	}
+
+	uint32_t u32() {
+		uint32_t value;
+		std::memcpy(&value, take(sizeof(value)), sizeof(value));
+		return be32toh(value);
+	}
+
+	uint64_t u64() {
+		uint64_t value;
+		std::memcpy(&value, take(sizeof(value)), sizeof(value));
+		return be64toh(value);
+	}
+
+	std::string str() {
+		auto size = u32();
+		return std::string(take(size), size);
+	}
+
+	bool done() const {
+		return offset == in.size();
+	}
+
+  private:
+	const std::string& in;
+	size_t offset = sizeof(UnixMessageCodec::MAGIC);
+
+	const char* take(size_t size) {
+		if (in.size() - offset < size) {
+			throw std::runtime_error("Truncated message");
+		}
+		auto data = in.data() + offset;
+		offset += size;
+		return data;
+	}
+};
+
+MessageType toMessageType(const std::string& type) {
+	if (type == "REQUEST") {
+		return MessageType::REQUEST;
+	}
+	if (type == "RESPONSE") {
+		return MessageType::RESPONSE;
+	}
+	if (type == "EVENT") {
+		return MessageType::EVENT;
+	}
+	throw std::runtime_error("Unknown message type " + type);
+}
+
+std::string fromMessageType(uint8_t type) {
+	switch (static_cast<MessageType>(type)) {
+		case MessageType::REQUEST:
+			return "REQUEST";
+		case MessageType::RESPONSE:
+			return "RESPONSE";
+		case MessageType::EVENT:
+			return "EVENT";
+	}
+	throw std::runtime_error("Unknown message type " + std::to_string(type));
+}
+
+void writeField(Writer& writer, const std::any& elem) {
+	if (elem.type() == typeid(std::string)) {
+		writer.u8(static_cast<uint8_t>(FieldTag::STRING));
+		writer.str(std::any_cast<std::string>(elem));
+	} else if (elem.type() == typeid(const char*)) {
+		writer.u8(static_cast<uint8_t>(FieldTag::STRING));
+		writer.str(std::any_cast<const char*>(elem));
+	} else if (elem.type() == typeid(bool)) {
+		writer.u8(static_cast<uint8_t>(FieldTag::BOOL));
+		writer.u8(std::any_cast<bool>(elem) ? 1 : 0);
+	} else if (elem.type() == typeid(int)) {
+		writer.u8(static_cast<uint8_t>(FieldTag::INT32));
+		writer.u32(static_cast<uint32_t>(std::any_cast<int>(elem)));
+	} else if (elem.type() == typeid(uint32_t)) {
+		writer.u8(static_cast<uint8_t>(FieldTag::UINT32));
+		writer.u32(std::any_cast<uint32_t>(elem));
+	} else if (elem.type() == typeid(long)) {
+		writer.u8(static_cast<uint8_t>(FieldTag::INT64));
+		writer.u64(static_cast<uint64_t>(std::any_cast<long>(elem)));
+	} else if (elem.type() == typeid(long long)) {
+		writer.u8(static_cast<uint8_t>(FieldTag::INT64));
+		writer.u64(static_cast<uint64_t>(std::any_cast<long long>(elem)));
+	} else if (elem.type() == typeid(unsigned long)) {
+		writer.u8(static_cast<uint8_t>(FieldTag::UINT64));
+		writer.u64(std::any_cast<unsigned long>(elem));
+	} else if (elem.type() == typeid(unsigned long long)) {
+		writer.u8(static_cast<uint8_t>(FieldTag::UINT64));
+		writer.u64(std::any_cast<unsigned long long>(elem));
+	} else if (elem.type() == typeid(double)) {
+		uint64_t bits;
+		auto value = std::any_cast<double>(elem);
+		std::memcpy(&bits, &value, sizeof(bits));
+		writer.u8(static_cast<uint8_t>(FieldTag::DOUBLE));
+		writer.u64(bits);
+	} else {
+		writer.u8(static_cast<uint8_t>(FieldTag::STRING));
+		writer.str("<unsupported>");
+	}
+}
+
+std::any readField(Reader& reader) {
+	auto tag = reader.u8();
+	switch (static_cast<FieldTag>(tag)) {
+		case FieldTag::STRING:
+			return reader.str();
+		case FieldTag::BOOL:
+			return reader.u8() != 0;
+		case FieldTag::INT32:
+			return static_cast<int>(reader.u32());
+		case FieldTag::UINT32:
+			return reader.u32();
+		case FieldTag::INT64:
+			// Same type as the numbers parsed from YAML
+			return static_cast<long long>(reader.u64());
+		case FieldTag::UINT64:
+			return reader.u64();
+		case FieldTag::DOUBLE: {
+			double value;
+			auto bits = reader.u64();
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+	}
+	throw std::runtime_error("Unknown field tag " + std::to_string(tag));
+}
+}  // namespace
+
+std::string UnixMessageCodec::encode(const UnixCommunicationMessage& msg) {
+	if (msg.data.size() > UINT16_MAX) {
+		throw std::runtime_error("Too many data fields: " + std::to_string(msg.data.size()));
+	}
+
+	Writer writer;
+	writer.out.reserve(64 + msg.name.size() + msg.id.size());
+	writer.out.append(MAGIC, sizeof(MAGIC));
+	writer.u8(static_cast<uint8_t>(toMessageType(msg.type)));
+	writer.u8(msg.error.has_value() ? FLAG_ERROR : 0);
+	writer.u16(msg.data.size());
+
+	writer.str(msg.name);
+	writer.str(msg.id);
+	if (msg.error.has_value()) {
+		writer.str(*msg.error);
+	}
+	for (const auto& elem : msg.data) {
+		writeField(writer, elem);
+	}
+	return std::move(writer.out);
+}
+
+bool UnixMessageCodec::isBinary(const std::string& payload) {
+	return payload.size() >= HEADER_BYTES && std::memcmp(payload.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+UnixCommunicationMessage UnixMessageCodec::decode(const std::string& payload) {
+	if (!isBinary(payload)) {
+		throw std::runtime_error("Not a binary message");
+	}
+
+	Reader reader(payload);
+	UnixCommunicationMessage msg;
+	msg.type   = fromMessageType(reader.u8());
+	auto flags = reader.u8();
+	auto count = reader.u16();
+
+	msg.name = reader.str();
+	msg.id	 = reader.str();
+	if (flags & FLAG_ERROR) {
+		msg.error = reader.str();
+	}
+
+	msg.data.reserve(count);
+	for (uint16_t i = 0; i < count; i++) {
+		msg.data.push_back(readField(reader));
+	}
+	if (!reader.done()) {
+		throw std::runtime_error("Trailing bytes after message");
+	}
+	return msg;
+}
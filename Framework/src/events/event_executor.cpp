@@ -0,0 +1,197 @@
+#include "framework/events/event_executor.hpp"
+
+#include <algorithm>
+#include <exception>
+
+EventExecutor::EventExecutor() : Loggable("EventExecutor") {
+	for (size_t lane = 0; lane < LANES; lane++) {
+		for (size_t i = 0; i < WORKERS; i++) {
+			workers.emplace_back(&EventExecutor::workerLoop, this, static_cast<EventLane>(lane));
+		}
+	}
+}
+
+EventExecutor::~EventExecutor() {
+	// Loggers may already be gone at exit, so no metrics here
+	halt();
+}
+
+EventExecutor::TopicId EventExecutor::registerTopic(const std::string& name, EventLane lane) {
+	std::lock_guard<std::mutex> lock(mtx);
+	auto it = topicIds.find(name);
+	if (it != topicIds.end()) {
+		return it->second;
+	}
+
+	// Topics are never removed, so ids are indexes and references to them stay valid
+	topics.emplace_back();
+	topics.back().name = name;
+	topics.back().lane = lane;
+	topicIds[name]	   = topics.size() - 1;
+	return topics.size() - 1;
+}
+
+void EventExecutor::submit(TopicId id, EventPriority priority, bool coalesce, std::function<void()>&& task) {
+	auto flowId = tracer.nextFlowId();
+	tracer.flowStart(flowId);
+	EventLane lane;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		if (!running) {
+			return;
+		}
+
+		auto& topic	= topics.at(id);
+		lane		= topic.lane;
+		if (coalesce) {
+			if (topic.hasLatest) {
+				// Keeps its queue time, only the latest state is handled
+				topic.latest.run	  = std::move(task);
+				topic.latest.priority = std::max(topic.latest.priority, priority);
+				topic.latest.flowId	  = flowId;
+				topic.stats.coalesced++;
+				return;
+			}
+			topic.latest	= Task{priority, Clock::now(), flowId, std::move(task)};
+			topic.hasLatest	= true;
+		} else {
+			topic.tasks.push_back(Task{priority, Clock::now(), flowId, std::move(task)});
+		}
+
+		queueDepth++;
+		maxQueueDepth = std::max(maxQueueDepth, queueDepth);
+	}
+	cvs[static_cast<size_t>(lane)].notify_one();
+}
+
+EventExecutor::Stats EventExecutor::getStats() {
+	std::lock_guard<std::mutex> lock(mtx);
+	Stats stats{queueDepth, maxQueueDepth, {}};
+	for (auto& topic : topics) {
+		stats.topics[topic.name] = topic.stats;
+	}
+	return stats;
+}
+
+void EventExecutor::stop() {
+	auto dropped = halt();
+	if (dropped > 0) {
+		logger->debug("Dropped {} pending event(s)", dropped);
+	}
+
+	auto stats = getStats();
+	logger->debug("Event metrics, max queue depth {}:", stats.maxQueueDepth);
+	Logger::add_tab();
+	for (auto& [name, topic] : stats.topics) {
+		auto handled = std::max<uint64_t>(topic.handled, 1);
+		logger->debug("{}: {} handled, {} coalesced, {} failed, wait {:.1f}/{:.1f} ms, run {:.1f}/{:.1f} ms (avg/max)", name, topic.handled,
+					  topic.coalesced, topic.failed, topic.waitMs / handled, topic.maxWaitMs, topic.runMs / handled, topic.maxRunMs);
+	}
+	Logger::rem_tab();
+}
+
+size_t EventExecutor::halt() {
+	size_t dropped = 0;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		if (!running) {
+			return 0;
+		}
+		running = false;
+		dropped = queueDepth;
+		for (auto& topic : topics) {
+			topic.tasks.clear();
+			topic.latest.run = nullptr;
+			topic.hasLatest	 = false;
+		}
+		queueDepth = 0;
+	}
+	for (auto& cv : cvs) {
+		cv.notify_all();
+	}
+
+	for (auto& worker : workers) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+	return dropped;
+}
+
+EventExecutor::Topic* EventExecutor::nextTopic(EventLane lane) {
+	// Only the oldest task of each topic can run, so the order within a topic is kept whatever the priorities
+	Topic* best		  = nullptr;
+	const Task* first = nullptr;
+	for (auto& topic : topics) {
+		if (topic.lane != lane || topic.running || (topic.tasks.empty() && !topic.hasLatest)) {
+			continue;
+		}
+		const Task* head = topic.tasks.empty() ? &topic.latest : &topic.tasks.front();
+		if (first == nullptr || head->priority > first->priority || (head->priority == first->priority && head->queued < first->queued)) {
+			best  = &topic;
+			first = head;
+		}
+	}
+	return best;
+}
+
+void EventExecutor::workerLoop(EventLane lane) {
+	auto& cv = cvs[static_cast<size_t>(lane)];
+	std::unique_lock<std::mutex> lock(mtx);
+	while (true) {
+		Topic* topic = nullptr;
+		cv.wait(lock, [this, lane, &topic] {
+			topic = nextTopic(lane);
+			return !running || topic != nullptr;
+		});
+		if (!running) {
+			return;
+		}
+
+		Task task;
+		if (!topic->tasks.empty()) {
+			task = std::move(topic->tasks.front());
+			topic->tasks.pop_front();
+		} else {
+			task			 = std::move(topic->latest);
+			topic->hasLatest = false;
+		}
+		queueDepth--;
+		topic->running = true;
+		lock.unlock();
+
+		auto start	= Clock::now();
+		bool failed = false;
+		try {
+			TraceSpan span("events", "handle", std::string(topic->name));
+			tracer.flowEnd(task.flowId);
+			task.run();
+		} catch (const std::exception& e) {
+			failed = true;
+			logger->error("Error while handling {}: {}", topic->name, e.what());
+		} catch (...) {
+			failed = true;
+			logger->error("Error while handling {}: unknown error", topic->name);
+		}
+		auto end = Clock::now();
+
+		double waitMs = std::chrono::duration<double, std::milli>(start - task.queued).count();
+		double runMs  = std::chrono::duration<double, std::milli>(end - start).count();
+		if (runMs > SLOW_TASK_MS) {
+			logger->warn("Handler for {} took {:.0f} ms", topic->name, runMs);
+		}
+
+		lock.lock();
+		topic->running = false;
+		auto& stats	   = topic->stats;
+		stats.handled++;
+		stats.failed += failed ? 1 : 0;
+		stats.waitMs += waitMs;
+		stats.maxWaitMs = std::max(stats.maxWaitMs, waitMs);
+		stats.runMs += runMs;
+		stats.maxRunMs = std::max(stats.maxRunMs, runMs);
+
+		// The topic may have queued work that was held back while this task ran
+		cv.notify_all();
+	}
+}
@@ -0,0 +1,181 @@
+#include "framework/logger/log_rotator.hpp"
+
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "framework/utils/file_utils.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+const int IOPRIO_WHO_PROCESS = 1;
+const int IOPRIO_CLASS_IDLE	 = 3;
+const int IOPRIO_CLASS_SHIFT = 13;
+}  // namespace
+
+LogRotator::LogRotator(const std::string& fileName, const fs::path& logDir) : fileName(fileName), logDir(logDir), oldDir(logDir / "old") {
+	FileUtils::mkdirs(logDir);
+	FileUtils::mkdirs(oldDir);
+	runner = std::thread(&LogRotator::compressLoop, this);
+}
+
+LogRotator::~LogRotator() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stop = true;
+	}
+	cv.notify_all();
+	if (runner.joinable()) {
+		runner.join();
+	}
+}
+
+void LogRotator::archivePrevious() {
+	auto current = logDir / (fileName + ".log");
+	if (FileUtils::exists(current)) {
+		enqueue(archive(current));
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& entry : fs::directory_iterator(oldDir)) {
+		auto name = entry.path().filename().string();
+		if (!entry.is_regular_file() || name.rfind(fileName + ".", 0) != 0) {
+			continue;
+		}
+		if (name.ends_with(".gz.tmp")) {
+			// Left by a compression that was interrupted
+			fs::remove(entry.path());
+		} else if (name.ends_with(".log") && std::find(pending.begin(), pending.end(), entry.path()) == pending.end()) {
+			pending.push_back(entry.path());
+		}
+	}
+	cv.notify_all();
+}
+
+fs::path LogRotator::archive(const fs::path& file) {
+	auto target = oldDir / (fileName + "." + stamp(FileUtils::getMTime(file)) + ".log");
+	fs::rename(file, target);
+	return target;
+}
+
+void LogRotator::enqueue(const fs::path& file) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.push_back(file);
+	}
+	cv.notify_all();
+}
+
+void LogRotator::compressLoop() {
+	pthread_setname_np(pthread_self(), "LogRotator");
+	// Compression must never compete with the daemon, neither for CPU nor for the disk
+	setpriority(PRIO_PROCESS, gettid(), 19);
+	syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, gettid(), IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		cv.wait(lock, [this] {
+			return stop || !pending.empty();
+		});
+		if (stop) {
+			return;
+		}
+
+		auto file = pending.front();
+		pending.pop_front();
+		lock.unlock();
+
+		try {
+			compress(file);
+			prune();
+		} catch (const std::exception& e) {
+			// Can't log from here, the logger is what is being rotated
+			std::cerr << "Error while archiving " << file.string() << ": " << e.what() << std::endl;
+		}
+
+		lock.lock();
+	}
+}
+
+void LogRotator::compress(const fs::path& file) {
+	auto target	   = fs::path(file.string() + ".gz");
+	auto temporary = fs::path(target.string() + ".tmp");
+
+	std::ifstream input(file, std::ios::binary);
+	if (!input) {
+		throw std::runtime_error("Couldn't open " + file.string());
+	}
+	gzFile output = gzopen(temporary.c_str(), "wb6");
+	if (!output) {
+		throw std::runtime_error("Couldn't open " + temporary.string());
+	}
+
+	char buffer[64 * 1024];
+	bool failed = false;
+	while (!stop && !failed && input) {
+		input.read(buffer, sizeof(buffer));
+		auto read = input.gcount();
+		failed	  = read > 0 && gzwrite(output, buffer, static_cast<unsigned>(read)) != read;
+	}
+	failed = gzclose(output) != Z_OK || failed;
+
+	if (stop || failed) {
+		fs::remove(temporary);
+		if (failed) {
+			throw std::runtime_error("Couldn't write " + temporary.string());
+		}
+		return;
+	}
+
+	fs::rename(temporary, target);
+	fs::remove(file);
+}
+
+void LogRotator::prune() {
+	std::vector<fs::directory_entry> archives;
+	for (auto& entry : fs::directory_iterator(oldDir)) {
+		auto name = entry.path().filename().string();
+		if (entry.is_regular_file() && name.rfind(fileName + ".", 0) == 0 && (name.ends_with(".log") || name.ends_with(".log.gz"))) {
+			archives.push_back(entry);
+		}
+	}
+
+	std::sort(archives.begin(), archives.end(), [](auto& a, auto& b) {
+		return a.last_write_time() > b.last_write_time();
+	});
+
+	uintmax_t total = 0;
+	for (auto& entry : archives) {
+		total += entry.file_size();
+		if (total > MAX_ARCHIVE_BYTES) {
+			fs::remove(entry.path());
+		}
+	}
+}
+
+std::string LogRotator::stamp(fs::file_time_type time) {
+	using namespace std::chrono;
+	auto sctp = time_point_cast<system_clock::duration>(time - fs::file_time_type::clock::now() + system_clock::now());
+	auto tt	  = system_clock::to_time_t(sctp);
+	auto ns	  = duration_cast<nanoseconds>(sctp.time_since_epoch()).count() % 1000000000;
+
+	std::tm tm{};
+	localtime_r(&tt, &tm);
+
+	std::ostringstream oss;
+	oss << std::put_time(&tm, "%Y%m%d.%H%M%S") << std::setw(3) << std::setfill('0') << (ns / 1000000);
+	return oss.str();
+}
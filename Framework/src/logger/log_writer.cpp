@@ -0,0 +1,278 @@
+#include "framework/logger/log_writer.hpp"
+
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+namespace {
+const int FATAL_SIGNALS[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+struct sigaction previousActions[std::size(FATAL_SIGNALS)];
+
+// Only async signal safe calls from here on, it is used from the fatal signal handler
+void writeRaw(int fd, const char* data, size_t size) {
+	while (size > 0) {
+		auto written = ::write(fd, data, size);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return;
+		}
+		data += written;
+		size -= written;
+	}
+}
+}  // namespace
+
+struct LogWriter::ThreadRing {
+	uint64_t writerId = 0;
+	std::shared_ptr<Ring> ring;
+
+	void release() {
+		if (ring) {
+			ring->owned = false;
+			ring.reset();
+		}
+	}
+
+	~ThreadRing() {
+		// Lines still queued are drained as usual, the ring is reused by the next thread
+		release();
+	}
+};
+
+LogWriter::LogWriter(std::shared_ptr<ConsoleSink> consoleSink, std::optional<std::shared_ptr<FileSink>> fileSink)
+	: id(++generations), consoleSink(consoleSink), fileSink(fileSink) {
+	runner = std::thread(&LogWriter::writerLoop, this);
+	active = this;
+	installSignalHandlers();
+}
+
+LogWriter::~LogWriter() {
+	LogWriter* self = this;
+	active.compare_exchange_strong(self, nullptr);
+
+	running = false;
+	wake();
+	if (runner.joinable()) {
+		runner.join();
+	}
+	flush();
+}
+
+void LogWriter::push(LoggerLevel level, std::string&& line) {
+	auto seq  = sequence++;
+	// Forked children have no writer thread and may have inherited a locked ring registry
+	auto ring = running ? ringForThread() : nullptr;
+	if (!ring) {
+		lockDrain();
+		collect();
+		batch.push_back(Record{seq, level, std::move(line)});
+		writeBatch();
+		unlockDrain();
+		return;
+	}
+
+	auto tail = ring->tail.load(std::memory_order_relaxed);
+	while (tail - ring->head.load() >= RING_SLOTS) {
+		wake();
+		std::this_thread::yield();
+	}
+	ring->slots[tail % RING_SLOTS] = Record{seq, level, std::move(line)};
+	ring->tail					   = tail + 1;
+	wake();
+}
+
+void LogWriter::flush() {
+	lockDrain();
+	collect();
+	writeBatch();
+	unlockDrain();
+}
+
+void LogWriter::writerLoop() {
+	while (running) {
+		pending.wait(false);
+		pending = false;
+		flush();
+	}
+}
+
+void LogWriter::wake() {
+	if (!pending.exchange(true)) {
+		pending.notify_one();
+	}
+}
+
+LogWriter::Ring* LogWriter::ringForThread() {
+	thread_local ThreadRing local;
+	if (local.writerId != id) {
+		local.release();
+		local.ring	   = claimRing();
+		local.writerId = id;
+	}
+	return local.ring.get();
+}
+
+std::shared_ptr<LogWriter::Ring> LogWriter::claimRing() {
+	std::lock_guard<std::mutex> lock(registryMutex);
+	auto count = ringCount.load();
+	for (size_t i = 0; i < count; i++) {
+		bool expected = false;
+		if (rings[i]->owned.compare_exchange_strong(expected, true)) {
+			return rings[i];
+		}
+	}
+	if (count == MAX_RINGS) {
+		return nullptr;
+	}
+
+	rings[count]		= std::make_shared<Ring>();
+	rings[count]->owned = true;
+	ringCount			= count + 1;
+	return rings[count];
+}
+
+void LogWriter::lockDrain() {
+	while (draining.test_and_set(std::memory_order_acquire)) {
+		std::this_thread::yield();
+	}
+}
+
+void LogWriter::unlockDrain() {
+	draining.clear(std::memory_order_release);
+}
+
+void LogWriter::collect() {
+	auto count = ringCount.load();
+	for (size_t i = 0; i < count; i++) {
+		auto& ring = *rings[i];
+		auto head  = ring.head.load(std::memory_order_relaxed);
+		auto tail  = ring.tail.load();
+		for (; head != tail; head++) {
+			batch.push_back(std::move(ring.slots[head % RING_SLOTS]));
+		}
+		ring.head = head;
+	}
+}
+
+void LogWriter::writeBatch() {
+	if (batch.empty()) {
+		return;
+	}
+
+	std::sort(batch.begin(), batch.end(), [](const Record& a, const Record& b) {
+		return a.sequence < b.sequence;
+	});
+
+	consoleBuffer.clear();
+	fileBuffer.clear();
+	for (auto& record : batch) {
+		consoleSink->append(consoleBuffer, record.line, record.level);
+		if (fileSink.has_value()) {
+			fileSink.value()->append(fileBuffer, record.line, record.level);
+		}
+	}
+	batch.clear();
+
+	try {
+		consoleSink->write(consoleBuffer);
+		if (fileSink.has_value()) {
+			fileSink.value()->write(fileBuffer);
+		}
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+	}
+}
+
+void LogWriter::emergencyFlush() {
+	// Gives a drain in progress some time to finish, but the crash may have happened inside it
+	timespec pause{0, 1000000};
+	for (int i = 0; i < 50 && draining.test_and_set(std::memory_order_acquire); i++) {
+		nanosleep(&pause, nullptr);
+	}
+
+	size_t heads[MAX_RINGS];
+	auto count = ringCount.load();
+	for (size_t i = 0; i < count; i++) {
+		heads[i] = rings[i]->head.load();
+	}
+
+	// Merges the rings in place, nothing can be allocated here
+	while (true) {
+		Record* next = nullptr;
+		size_t from	 = 0;
+		for (size_t i = 0; i < count; i++) {
+			if (heads[i] == rings[i]->tail.load()) {
+				continue;
+			}
+			auto& record = rings[i]->slots[heads[i] % RING_SLOTS];
+			if (!next || record.sequence < next->sequence) {
+				next = &record;
+				from = i;
+			}
+		}
+		if (!next) {
+			break;
+		}
+		heads[from]++;
+
+		auto color = colorCode(next->level);
+		writeRaw(consoleSink->descriptor(), color, std::strlen(color));
+		writeRaw(consoleSink->descriptor(), next->line.data(), next->line.size());
+		writeRaw(consoleSink->descriptor(), "\033[0m", 4);
+		if (fileSink.has_value()) {
+			writeRaw(fileSink.value()->descriptor(), next->line.data(), next->line.size());
+		}
+	}
+}
+
+void LogWriter::installSignalHandlers() {
+	static std::once_flag installed;
+	std::call_once(installed, [] {
+		struct sigaction action{};
+		action.sa_handler = &LogWriter::onFatalSignal;
+		sigemptyset(&action.sa_mask);
+		for (size_t i = 0; i < std::size(FATAL_SIGNALS); i++) {
+			sigaction(FATAL_SIGNALS[i], &action, &previousActions[i]);
+		}
+		pthread_atfork(nullptr, nullptr, &LogWriter::onFork);
+	});
+}
+
+void LogWriter::onFork() {
+	// The writer thread doesn't exist in the child, lines are written by the caller from now on
+	auto writer = active.load();
+	if (writer) {
+		writer->running = false;
+		writer->draining.clear();
+
+		// Inherited lines are the parent's to write
+		auto count = writer->ringCount.load();
+		for (size_t i = 0; i < count; i++) {
+			writer->rings[i]->head = writer->rings[i]->tail.load();
+		}
+	}
+}
+
+void LogWriter::onFatalSignal(int signal) {
+	auto writer = active.load();
+	if (writer) {
+		writer->emergencyFlush();
+	}
+
+	// Hands the signal to whatever was installed before, usually the default action
+	for (size_t i = 0; i < std::size(FATAL_SIGNALS); i++) {
+		if (FATAL_SIGNALS[i] == signal) {
+			sigaction(signal, &previousActions[i], nullptr);
+		}
+	}
+	raise(signal);
+}
@@ -1,12 +1,26 @@
 #include "framework/logger/logger.hpp"
 
+#include <array>
 #include <chrono>
 #include <ctime>
-#include <iomanip>
 #include <memory>
 
 #include "framework/utils/enum_utils.hpp"
 
+namespace {
+const std::string& levelLabel(LoggerLevel level) {
+	// Padded once, indexed by level
+	static const std::array<std::string, 6> labels = [] {
+		std::array<std::string, 6> result;
+		for (auto value : values<LoggerLevel>()) {
+			result[toInt(value)] = StringUtils::rightPad(toName(value), 7).substr(0, 7);
+		}
+		return result;
+	}();
+	return labels[toInt(level)];
+}
+}  // namespace
+
 void Logger::setLevel(const std::string& level) {
 	this->setLevel(fromName<LoggerLevel>(level));
 }
@@ -25,11 +39,13 @@ void Logger::setLevel(LoggerLevel level) {
  *
  * @param name
  */
-Logger::Logger(std::shared_ptr<ConsoleSink> console_sink, std::optional<std::shared_ptr<FileSink>> fileSink, std::string name) {
-	std::lock_guard<std::mutex> lock(mutex);
-	this->consoleSink = console_sink;
-	this->fileSink	  = fileSink;
-	this->name		  = StringUtils::rightPad(name, 20).substr(0, 20);
+Logger::Logger(std::shared_ptr<LogWriter> writer, std::string name) {
+	this->writer = writer;
+	this->name	 = StringUtils::rightPad(name, 20).substr(0, 20);
+}
+
+bool Logger::isEnabled(LoggerLevel level) const {
+	return toInt(level) <= toInt(this->level.load(std::memory_order_relaxed));
 }
 
 /**
@@ -88,43 +104,56 @@ void Logger::critical(const std::string& message) {
 }
 
 void Logger::add_tab() {
-	std::lock_guard<std::mutex> lock(mutex);
-	tabs += 1;
+	tabs++;
 }
 
 void Logger::rem_tab() {
-	std::lock_guard<std::mutex> lock(mutex);
-	tabs = std::max(0, tabs - 1);
+	int current = tabs;
+	while (current > 0 && !tabs.compare_exchange_weak(current, current - 1)) {
+	}
 }
 
 void Logger::log(LoggerLevel msgLevel, const std::string& format) {
-	if (toInt(msgLevel) > toInt(level)) {
+	if (!isEnabled(msgLevel)) {
 		return;
 	}
 
-	std::lock_guard<std::mutex> lock(mutex);
-
-	auto out = "[" + now_timestamp() + "][" + StringUtils::rightPad(toName(msgLevel), 7).substr(0, 7) + "][" + name + "] - " +
-			   StringUtils::rightPad("", tabs * 2) + format + "\n";
-	consoleSink->write(out, msgLevel);
-	if (fileSink.has_value()) {
-		fileSink.value()->write(out, msgLevel);
-	}
+	std::string out;
+	out.reserve(64 + name.size() + format.size());
+	out += '[';
+	append_timestamp(out);
+	out += "][";
+	out += levelLabel(msgLevel);
+	out += "][";
+	out += name;
+	out += "] - ";
+	out.append(tabs.load(std::memory_order_relaxed) * 2, ' ');
+	out += format;
+	out += '\n';
+	writer->push(msgLevel, std::move(out));
 }
 
-std::string Logger::now_timestamp() {
+void Logger::append_timestamp(std::string& out) {
 	using namespace std::chrono;
 
+	// Date and time only change once per second, the milliseconds are appended by hand
+	thread_local int64_t cachedSecond = -1;
+	thread_local char cachedPrefix[32];
+
 	auto now  = system_clock::now();
 	auto secs = time_point_cast<seconds>(now);
 	auto ms	  = duration_cast<milliseconds>(now - secs).count();
 
-	std::time_t tt = system_clock::to_time_t(secs);
-	std::tm tm{};
-	localtime_r(&tt, &tm);
-
-	std::ostringstream oss;
-	oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << '.' << std::setw(3) << std::setfill('0') << ms;
+	if (secs.time_since_epoch().count() != cachedSecond) {
+		std::time_t tt = system_clock::to_time_t(secs);
+		std::tm tm{};
+		localtime_r(&tt, &tm);
+		std::strftime(cachedPrefix, sizeof(cachedPrefix), "%Y-%m-%d %H:%M:%S.", &tm);
+		cachedSecond = secs.time_since_epoch().count();
+	}
 
-	return oss.str();
-}
\ No newline at end of file
+	out += cachedPrefix;
+	out += static_cast<char>('0' + ms / 100);
+	out += static_cast<char>('0' + ms / 10 % 10);
+	out += static_cast<char>('0' + ms % 10);
+}
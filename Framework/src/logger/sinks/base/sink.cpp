@@ -0,0 +1,27 @@
+#include "framework/logger/sink/base/sink.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+void Sink::append(std::string& batch, const std::string& line, LoggerLevel _) const {
+	batch += line;
+}
+
+void Sink::write(const std::string& batch) {
+	const char* data = batch.data();
+	size_t pending	 = batch.size();
+	while (pending > 0) {
+		auto written = ::write(descriptor(), data, pending);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw std::runtime_error(std::string("Error writing log: ") + std::strerror(errno));
+		}
+		data += written;
+		pending -= written;
+	}
+}
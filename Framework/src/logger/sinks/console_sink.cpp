@@ -1,8 +1,13 @@
 #include "framework/logger/sink/console_sink.hpp"
 
-#include <iostream>
+#include <unistd.h>
 
-void ConsoleSink::write(const std::string& message, LoggerLevel level) {
-	std::cout << colorCode(level) << message << "\033[0m";
-	std::cout.flush();
-}
\ No newline at end of file
+void ConsoleSink::append(std::string& batch, const std::string& line, LoggerLevel level) const {
+	batch += colorCode(level);
+	batch += line;
+	batch += "\033[0m";
+}
+
+int ConsoleSink::descriptor() const {
+	return STDOUT_FILENO;
+}
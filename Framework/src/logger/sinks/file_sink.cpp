@@ -1,24 +1,56 @@
 #include "framework/logger/sink/file_sink.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <filesystem>
 #include <stdexcept>
 
-FileSink::FileSink(const std::string& filename) {
-	file.open(filename, std::ios::out | std::ios::binary);
-	if (!file.is_open()) {
-		throw std::runtime_error("Couldn't open file: " + filename);
-	}
+FileSink::FileSink(const std::string& filename, std::shared_ptr<LogRotator> rotator) : filename(filename), rotator(rotator) {
+	fd	   = openFile(filename);
+	opened = std::chrono::steady_clock::now();
 }
 
 FileSink::~FileSink() {
-	if (file.is_open()) {
-		file.close();
+	close(fd);
+}
+
+void FileSink::write(const std::string& batch) {
+	Sink::write(batch);
+
+	written += batch.size();
+	if (rotator && (written >= MAX_FILE_BYTES || std::chrono::steady_clock::now() - opened >= MAX_FILE_AGE)) {
+		rotate();
+	}
+}
+
+int FileSink::descriptor() const {
+	return fd;
+}
+
+void FileSink::rotate() {
+	// A failed rotation is retried once the limits are hit again, not on every batch
+	written = 0;
+	opened	= std::chrono::steady_clock::now();
+
+	auto archived = rotator->archive(filename);
+	int next;
+	try {
+		next = openFile(filename);
+	} catch (std::exception& e) {
+		// Moved back so the current descriptor keeps writing into the live log
+		std::error_code ec;
+		std::filesystem::rename(archived, filename, ec);
+		throw;
 	}
+	close(fd.exchange(next));
+	rotator->enqueue(archived);
 }
 
-void FileSink::write(const std::string& message, LoggerLevel _) {
-	file.write(message.c_str(), message.length());
-	if (!file) {
-		throw std::runtime_error("Error writing into file");
+int FileSink::openFile(const std::string& filename) {
+	int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		throw std::runtime_error("Couldn't open file: " + filename);
 	}
-	file.flush();
-}
\ No newline at end of file
+	return fd;
+}
@@ -11,6 +11,7 @@
 #include <stdexcept>
 #include <string>
 
+#include "framework/tracing/tracer.hpp"
 #include "framework/utils/string_utils.hpp"
 
 namespace {
@@ -122,6 +123,7 @@ void Shell::close_bash(BashSession& session) {
 
 CommandResult Shell::send_command(BashSession& session, bool elevated, const std::string& cmd, bool check, uint8_t timeout) {
 	std::lock_guard<std::mutex> lock(mtx);
+	TraceSpan span("shell", elevated ? "elevated command" : "command", std::string(cmd));
 	if (elevated) {
 		logger->debug("Running admin command {}", cmd);
 	} else {
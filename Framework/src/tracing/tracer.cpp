@@ -0,0 +1,200 @@
+#include "framework/tracing/tracer.hpp"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+std::string escape(std::string_view value) {
+	std::string out;
+	out.reserve(value.size());
+	for (char c : value) {
+		switch (c) {
+			case '"':
+				out += "\\\"";
+				break;
+			case '\\':
+				out += "\\\\";
+				break;
+			case '\n':
+				out += "\\n";
+				break;
+			case '\t':
+				out += "\\t";
+				break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					out += std::format("\\u{:04x}", c);
+				} else {
+					out += c;
+				}
+		}
+	}
+	return out;
+}
+}  // namespace
+
+struct Tracer::ThreadHolder {
+	std::shared_ptr<ThreadBuffer> buffer;
+
+	~ThreadHolder() {
+		// Threads may outlive the tracer at process exit
+		if (buffer && Tracer::alive.load()) {
+			Tracer::getInstance().retire(buffer);
+		}
+	}
+};
+
+Tracer::Tracer() : enabled(std::getenv("RCC_TRACE") != nullptr), epoch(Clock::now()) {
+	alive = true;
+}
+
+Tracer::~Tracer() {
+	alive = false;
+}
+
+bool Tracer::isEnabled() const {
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::setEnabled(bool value) {
+	enabled = value;
+}
+
+void Tracer::complete(std::string_view category, std::string_view name, Clock::time_point start, Clock::time_point end,
+					  std::string&& detail) {
+	if (isEnabled()) {
+		record(Event{'X', category, name, sinceEpoch(start), sinceEpoch(end) - sinceEpoch(start), 0, std::move(detail)});
+	}
+}
+
+void Tracer::instant(std::string_view category, std::string_view name, std::string&& detail) {
+	if (isEnabled()) {
+		record(Event{'i', category, name, sinceEpoch(Clock::now()), 0, 0, std::move(detail)});
+	}
+}
+
+uint64_t Tracer::nextFlowId() {
+	return ++flowIds;
+}
+
+void Tracer::flowStart(uint64_t id) {
+	if (isEnabled()) {
+		record(Event{'s', "flow", "handover", sinceEpoch(Clock::now()), 0, id, ""});
+	}
+}
+
+void Tracer::flowEnd(uint64_t id) {
+	if (isEnabled()) {
+		record(Event{'f', "flow", "handover", sinceEpoch(Clock::now()), 0, id, ""});
+	}
+}
+
+size_t Tracer::exportJson(const std::string& path) {
+	std::vector<std::shared_ptr<ThreadBuffer>> snapshot;
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+		snapshot.assign(exited.begin(), exited.end());
+		snapshot.insert(snapshot.end(), buffers.begin(), buffers.end());
+	}
+
+	std::ofstream file(path, std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Couldn't open " + path);
+	}
+
+	auto pid	 = getpid();
+	size_t count = 0;
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (auto& buffer : snapshot) {
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		file << (count > 0 ? "," : "")
+			 << std::format("\n{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":{},\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}", pid, buffer->tid,
+							escape(buffer->threadName));
+		count++;
+
+		// Oldest first, the ring wraps once full
+		auto size = buffer->events.size();
+		for (size_t i = 0; i < size; i++) {
+			auto& event = buffer->events[(buffer->next + i) % size];
+			file << std::format(",\n{{\"ph\":\"{}\",\"cat\":\"{}\",\"name\":\"{}\",\"pid\":{},\"tid\":{},\"ts\":{:.3f}", event.phase,
+								escape(event.category), escape(event.name), pid, buffer->tid, event.startNs / 1000.0);
+			if (event.phase == 'X') {
+				file << std::format(",\"dur\":{:.3f}", event.durationNs / 1000.0);
+			} else if (event.phase == 'i') {
+				file << ",\"s\":\"t\"";
+			} else {
+				file << std::format(",\"id\":{},\"bp\":\"e\"", event.id);
+			}
+			if (!event.detail.empty()) {
+				file << std::format(",\"args\":{{\"detail\":\"{}\"}}", escape(event.detail));
+			}
+			file << "}";
+			count++;
+		}
+	}
+	file << "\n]}\n";
+
+	return count;
+}
+
+void Tracer::record(Event&& event) {
+	auto& buffer = threadBuffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	if (buffer.events.size() < EVENTS_PER_THREAD) {
+		buffer.events.push_back(std::move(event));
+	} else {
+		buffer.events[buffer.next] = std::move(event);
+		buffer.next				   = (buffer.next + 1) % EVENTS_PER_THREAD;
+	}
+}
+
+Tracer::ThreadBuffer& Tracer::threadBuffer() {
+	thread_local ThreadHolder holder;
+	auto& buffer = holder.buffer;
+	if (!buffer) {
+		buffer		= std::make_shared<ThreadBuffer>();
+		buffer->tid = gettid();
+
+		char name[16] = {};
+		pthread_getname_np(pthread_self(), name, sizeof(name));
+		buffer->threadName = std::format("{} ({})", name, buffer->tid);
+
+		std::lock_guard<std::mutex> lock(registryMutex);
+		buffers.push_back(buffer);
+	}
+	return *buffer;
+}
+
+void Tracer::retire(const std::shared_ptr<ThreadBuffer>& buffer) {
+	// Threads come and go, e.g. one per effect run, only the last ones are worth keeping
+	std::lock_guard<std::mutex> lock(registryMutex);
+	buffers.erase(std::remove(buffers.begin(), buffers.end(), buffer), buffers.end());
+	exited.push_back(buffer);
+	if (exited.size() > MAX_EXITED_THREADS) {
+		exited.pop_front();
+	}
+}
+
+int64_t Tracer::sinceEpoch(Clock::time_point time) const {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(time - epoch).count();
+}
+
+TraceSpan::TraceSpan(std::string_view category, std::string_view name, std::string&& detail)
+	: tracer(Tracer::getInstance()), active(tracer.isEnabled()), category(category), name(name) {
+	if (active) {
+		this->detail = std::move(detail);
+		start		 = Tracer::Clock::now();
+	}
+}
+
+TraceSpan::~TraceSpan() {
+	if (active) {
+		tracer.complete(category, name, start, Tracer::Clock::now(), std::move(detail));
+	}
+}
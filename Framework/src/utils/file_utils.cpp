@@ -1,7 +1,12 @@
 #include "framework/utils/file_utils.hpp"
 
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
@@ -35,6 +40,52 @@ void FileUtils::writeFileContent(const std::string& path, const std::string& con
 	file.close();
 }
 
+void FileUtils::replaceFileContent(const std::string& path, const std::string& content) {
+	auto temporary = path + ".tmp";
+	int fd		   = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		throw std::runtime_error("Couldn't open file " + temporary);
+	}
+
+	const char* data = content.data();
+	size_t pending	 = content.size();
+	while (pending > 0) {
+		auto written = write(fd, data, pending);
+		if (written < 0 && errno == EINTR) {
+			continue;
+		}
+		if (written < 0) {
+			auto error = std::string(std::strerror(errno));
+			close(fd);
+			std::filesystem::remove(temporary);
+			throw std::runtime_error("Couldn't write file " + temporary + ": " + error);
+		}
+		data += written;
+		pending -= written;
+	}
+
+	if (fsync(fd) != 0 || close(fd) != 0) {
+		auto error = std::string(std::strerror(errno));
+		std::filesystem::remove(temporary);
+		throw std::runtime_error("Couldn't sync file " + temporary + ": " + error);
+	}
+
+	std::filesystem::rename(temporary, path);
+
+	// The rename is only durable once the directory entry is on disk
+	auto parent = std::filesystem::absolute(path).parent_path();
+	int dirFd	= open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (dirFd < 0) {
+		throw std::runtime_error("Couldn't open directory " + parent.string());
+	}
+	int synced = fsync(dirFd);
+	auto error = std::string(std::strerror(errno));
+	close(dirFd);
+	if (synced != 0) {
+		throw std::runtime_error("Couldn't sync directory " + parent.string() + ": " + error);
+	}
+}
+
 std::string FileUtils::readFileContent(const std::string& path) {
 	std::ifstream file(path, std::ios::in);
 	if (!file.is_open()) {
@@ -110,4 +161,33 @@ std::vector<std::string> FileUtils::listDirectory(const std::string& path) {
 		entries.push_back(entry.path().filename().string());
 	}
 	return entries;
+}
+
+std::vector<std::string> FileUtils::findInPath(const std::string& command) {
+	auto isExecutable = [](const std::string& file) {
+		struct stat st;
+		return stat(file.c_str(), &st) == 0 && S_ISREG(st.st_mode) && access(file.c_str(), X_OK) == 0;
+	};
+
+	std::vector<std::string> found;
+	if (command.empty()) {
+		return found;
+	}
+	if (command.find('/') != std::string::npos) {
+		if (isExecutable(command)) {
+			found.push_back(command);
+		}
+		return found;
+	}
+
+	const char* path = std::getenv("PATH");
+	std::istringstream dirs(path ? path : "");
+	std::string dir;
+	while (std::getline(dirs, dir, ':')) {
+		auto file = (dir.empty() ? std::string(".") : dir) + "/" + command;
+		if (isExecutable(file) && std::find(found.begin(), found.end(), file) == found.end()) {
+			found.push_back(file);
+		}
+	}
+	return found;
 }
\ No newline at end of file
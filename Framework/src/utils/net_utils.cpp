@@ -3,6 +3,7 @@
 #include <netinet/in.h>
 #include <unistd.h>
 
+#include <fstream>
 #include <regex>
 #include <stdexcept>
 
@@ -1,6 +1,7 @@
 #include "framework/utils/process_utils.hpp"
 
 #include <cstdint>
+#include <fstream>
 #include <set>
 #include <string>
 
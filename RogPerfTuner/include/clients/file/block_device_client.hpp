@@ -0,0 +1,77 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "framework/abstracts/loggable.hpp"
+#include "framework/abstracts/singleton.hpp"
+#include "framework/shell/shell.hpp"
+#include "models/settings/block_device_tuning.hpp"
+
+class BlockDeviceClient : public Singleton<BlockDeviceClient>, Loggable {
+  public:
+	/**
+	 * @brief Checks if there is any tunable block device.
+	 *
+	 * @return true if at least one device was found, false otherwise.
+	 */
+	bool available();
+
+	/**
+	 * @brief Gets the names of the tunable block devices.
+	 *
+	 * @return A vector of device names (e.g. nvme0n1, sda).
+	 */
+	std::vector<std::string> getDevices();
+
+	/**
+	 * @brief Gets the block devices backing the Steam libraries.
+	 *
+	 * @return A set of device names.
+	 */
+	std::set<std::string> getSteamDevices();
+
+	/**
+	 * @brief Gets the IO schedulers supported by a device.
+	 *
+	 * @param device The device name.
+	 * @return A vector of scheduler names.
+	 */
+	std::vector<std::string> getAvailableSchedulers(const std::string& device);
+
+	/**
+	 * @brief Overrides part of the default tuning restored when a preset doesn't set a value.
+	 *
+	 * @param prefix Prefix of the devices affected (e.g. nvme).
+	 * @param tuning Values to store as default.
+	 */
+	void setDefaults(const std::string& prefix, const BlockDeviceTuning& tuning);
+
+	/**
+	 * @brief Applies an IO preset, restoring defaults for every value not set by it.
+	 *
+	 * Only the queue attributes whose value changes are written.
+	 *
+	 * @param preset The preset to apply.
+	 */
+	void apply(const IoPreset& preset);
+
+  private:
+	friend class Singleton<BlockDeviceClient>;
+	BlockDeviceClient();
+
+	std::vector<std::string> devices;
+	std::set<std::string> steamDevices;
+	std::map<std::string, std::vector<std::string>> schedulers;
+	std::map<std::string, BlockDeviceTuning> defaults;
+	std::map<std::string, BlockDeviceTuning> current;
+
+	Shell& shell = Shell::getInstance();
+
+	BlockDeviceTuning readTuning(const std::string& device);
+	std::set<std::string> resolveSteamDevices();
+	std::optional<std::string> resolveDevice(const std::string& path);
+};
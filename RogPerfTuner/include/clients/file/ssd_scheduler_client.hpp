@@ -16,5 +16,4 @@ class SsdSchedulerClient : public AbstractGlobClient, public Singleton<SsdSchedu
   public:
 	std::string getCurrentScheduler();
 	std::vector<std::string> getAvailableSchedulers();
-	void setSchedulers(const std::string&);
 };
\ No newline at end of file
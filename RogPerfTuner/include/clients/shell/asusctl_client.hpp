@@ -22,6 +22,13 @@ class AsusCtlClient : public AbstractCmdClient, public Singleton<AsusCtlClient>
 	 */
 	void turnOffAura();
 
+	/**
+	 * @brief Sets the Aura lighting to a static color.
+	 *
+	 * @param color Color in RRGGBB hexadecimal format, with or without a leading '#'.
+	 */
+	void setAuraColor(const std::string& color);
+
 #ifdef FAN_CONTROL
 	/**
 	 * @brief Resets the fan or performance curves to their default values for the specified platform profile.
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "framework/abstracts/loggable.hpp"
+
+/**
+ * @brief Captures audio and publishes its spectrum bands.
+ *
+ * Samples come from the default PipeWire/PulseAudio monitor through parec, or from a WAV file played
+ * in real time. Analysis runs on the capture thread and the bands are handed to the reader through a
+ * lock-free triple buffer, so neither side ever blocks the other.
+ */
+class AudioCapture : public Loggable {
+  public:
+	inline static const uint32_t SAMPLE_RATE = 48000;
+	inline static const size_t WINDOW		 = 1024;
+	inline static const size_t HOP			 = 256;
+	inline static const size_t BANDS		 = 16;
+
+	AudioCapture();
+	~AudioCapture();
+
+	/**
+	 * @brief Starts capturing, stopping any previous capture.
+	 *
+	 * @param wavFile WAV file to play instead of the monitor, looped until stopped.
+	 */
+	void start(const std::optional<std::string>& wavFile = std::nullopt);
+
+	/**
+	 * @brief Stops capturing and releases the source.
+	 */
+	void stop();
+
+	/**
+	 * @brief Gets the latest bands if there are new ones.
+	 *
+	 * @param levels Receives one level in [0, 1] per band, untouched if there is nothing new.
+	 * @return true if the levels were updated, false otherwise.
+	 */
+	bool read(std::vector<float>& levels);
+
+  private:
+	inline static const uint8_t DIRTY = 4;
+
+	std::thread _thread;
+	std::atomic<bool> _running = false;
+	pid_t _pid				   = -1;
+	int _fd					   = -1;
+
+	std::array<std::vector<float>, 3> _buffers;
+	std::atomic<uint8_t> _middle = 1;
+	uint8_t _back				 = 0;
+	uint8_t _front				 = 2;
+
+	void captureMonitor();
+	void captureWav(const std::string& path);
+	void publish(const std::vector<float>& levels);
+};
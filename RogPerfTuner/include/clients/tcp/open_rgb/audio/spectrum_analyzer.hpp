@@ -0,0 +1,65 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Splits an audio stream into logarithmic frequency bands.
+ *
+ * Runs a Hann windowed real FFT over the last window of samples every time a hop is complete.
+ * All buffers are allocated on construction and reused.
+ */
+class SpectrumAnalyzer {
+  public:
+	/**
+	 * @brief Creates the analyzer.
+	 *
+	 * @param size Window size, must be a power of two.
+	 * @param hop Samples between consecutive analyses.
+	 * @param sampleRate Sample rate of the stream.
+	 * @param bands Number of output bands.
+	 */
+	SpectrumAnalyzer(size_t size, size_t hop, uint32_t sampleRate, size_t bands);
+
+	/**
+	 * @brief Feeds mono samples.
+	 *
+	 * @param samples Samples in [-1, 1].
+	 * @return true if at least one analysis was run, false otherwise.
+	 */
+	bool push(std::span<const float> samples);
+
+	/**
+	 * @brief Gets the level of every band from the last analysis.
+	 *
+	 * @return One level in [0, 1] per band.
+	 */
+	std::span<const float> levels() const;
+
+  private:
+	inline static const double MIN_FREQ	 = 40.0;
+	inline static const double MAX_FREQ	 = 16000.0;
+	inline static const double FLOOR_DB	 = -70.0;
+	inline static const double RANGE_DB	 = 60.0;
+	inline static const double PEAK_FALL = 0.995;
+
+	size_t _size;
+	size_t _hop;
+	size_t _position = 0;
+	size_t _pending;
+	std::vector<float> _history;
+	std::vector<float> _window;
+	std::vector<std::complex<float>> _data;
+	std::vector<std::complex<float>> _twiddles;
+	std::vector<std::complex<float>> _split;
+	std::vector<uint32_t> _reversed;
+	std::vector<size_t> _edges;
+	std::vector<float> _levels;
+	float _peak = 0;
+
+	void analyze();
+	void fft();
+};
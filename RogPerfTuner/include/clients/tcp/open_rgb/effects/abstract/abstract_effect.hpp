@@ -1,13 +1,17 @@
 #pragma once
 
-#include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <optional>
+#include <random>
+#include <span>
 #include <string>
-#include <thread>
+#include <vector>
 
 #include "OpenRGB/Client.hpp"
+#include "clients/tcp/open_rgb/render/frame_time.hpp"
+#include "clients/tcp/open_rgb/render/geometry_index.hpp"
 #include "framework/abstracts/loggable.hpp"
-#include "models/hardware/rgb_brightness.hpp"
 
 using orgb::Client;
 using orgb::Color;
@@ -22,36 +26,132 @@ using orgb::RequestStatus;
 
 class AbstractEffect : public Loggable {
   protected:
-	bool _is_running   = false;
-	double _brightness = 0;
 	std::string _name;
-	std::mutex _mutex;
-	std::thread _thread;
-	Client& _client;
-	std::optional<Color> _color;
+	bool _hasColor = false;
+	// Read by the render thread on every frame, so a new color shows up without restarting the effect
+	std::atomic<Color> _color;
+	uint32_t _min_fps = 10;
+	uint32_t _max_fps = 60;
+	std::mt19937 _rng;
+	std::optional<uint32_t> _seed;
+
+	/**
+	 * @brief Moves the state of the devices that are still attached to their new index, creating it for the new ones.
+	 *
+	 * @param states State per device of the previous list.
+	 * @param previous Index of every device in the previous list, std::nullopt for the new ones.
+	 * @param create Builds the state of a new device from its index.
+	 * @return State per device of the new list.
+	 */
+	template <typename S, typename F>
+	static std::vector<S> carryOver(std::vector<S>& states, const std::vector<std::optional<size_t>>& previous, F&& create) {
+		std::vector<S> result;
+		result.reserve(previous.size());
+		for (size_t d = 0; d < previous.size(); d++) {
+			if (previous[d].has_value() && *previous[d] < states.size()) {
+				result.push_back(std::move(states[*previous[d]]));
+			} else {
+				result.push_back(create(d));
+			}
+		}
+		return result;
+	}
 
   public:
-	AbstractEffect(Client& client, const std::string& name, const std::optional<std::string>& color = std::nullopt);
+	AbstractEffect(const std::string& name, const std::optional<std::string>& color = std::nullopt);
 
-	virtual ~AbstractEffect() {
-		stop();
-	}
+	virtual ~AbstractEffect() = default;
 
 	const std::string getName();
 
-	void start(const DeviceList& devices, const RgbBrightness& brightness);
-	void stop();
-
 	void setColor(std::string color);
 	std::optional<std::string> getColor();
 	bool supportsColor();
 
-  protected:
-	void _sleep(double seconds);
+	/**
+	 * @brief Gets the lowest frame rate at which the effect still looks smooth.
+	 *
+	 * @return Frames per second.
+	 */
+	uint32_t getMinFps();
+
+	/**
+	 * @brief Gets the highest frame rate the effect can take advantage of.
+	 *
+	 * @return Frames per second.
+	 */
+	uint32_t getMaxFps();
+
+	/**
+	 * @brief Fixes the seed of the random generator so the effect renders the same frames on every run.
+	 *
+	 * @param seed The seed, or std::nullopt to take a new one from the system every time.
+	 */
+	void setSeed(std::optional<uint32_t> seed);
+
+	/**
+	 * @brief Reseeds the random generator, called by the render engine before prepare().
+	 */
+	void reseed();
+
+	/**
+	 * @brief Prepares the effect state for the given devices.
+	 *
+	 * Called from the render thread before the first frame and whenever the device list changes.
+	 *
+	 * @param devices The devices that will be rendered.
+	 * @param geometry Position of every LED of the devices.
+	 */
+	virtual void prepare(const DeviceList& devices, const GeometryIndex& geometry);
+
+	/**
+	 * @brief Adapts the effect state to a new device list while it is being rendered.
+	 *
+	 * Called from the render thread instead of prepare() when the effect resumes after a device change. Devices
+	 * that stay attached should keep their state so they don't restart from black, the default prepares the
+	 * effect again.
+	 *
+	 * @param devices The devices that will be rendered.
+	 * @param geometry Position of every LED of the devices.
+	 * @param previous Index of every device in the previous list, std::nullopt for the new ones.
+	 */
+	virtual void remap(const DeviceList& devices, const GeometryIndex& geometry, const std::vector<std::optional<size_t>>& previous);
+
+	/**
+	 * @brief Advances the state shared by all devices.
+	 *
+	 * Called once per frame, before any device is rendered.
+	 *
+	 * @param time Timing of the current frame.
+	 */
+	virtual void tick(const FrameTime& time);
+
+	/**
+	 * @brief Renders a frame for a device.
+	 *
+	 * The buffer holds the previous frame rendered for the device, so effects only need to write the LEDs that change.
+	 * Colors are written at full brightness, dimming is applied by the render engine.
+	 *
+	 * @param time Timing of the current frame for this device.
+	 * @param dev The device being rendered.
+	 * @param devIdx Index of the device in the list given to prepare().
+	 * @param leds Buffer with one color per device LED.
+	 */
+	virtual void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) = 0;
 
-	void _set_colors(Device& dev, const std::vector<orgb::Color>& colors);
-	virtual void apply_effect(const DeviceList& devices) = 0;
+	/**
+	 * @brief Gets the single color the effect shows on every LED, if it has one.
+	 *
+	 * Effects with a solid color can be applied through the keyboard firmware without rendering.
+	 *
+	 * @return The color, or std::nullopt for animated or per LED effects.
+	 */
+	virtual std::optional<Color> getSolidColor();
 
-  private:
-	void _thread_main(const DeviceList& devices);
-};
\ No newline at end of file
+	/**
+	 * @brief Releases the resources taken by prepare().
+	 *
+	 * Called from the render thread once the effect stops being rendered.
+	 */
+	virtual void finish();
+};
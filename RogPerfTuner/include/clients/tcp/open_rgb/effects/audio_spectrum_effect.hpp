@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "clients/tcp/open_rgb/audio/audio_capture.hpp"
+#include "clients/tcp/open_rgb/effects/abstract/abstract_effect.hpp"
+#include "framework/abstracts/singleton.hpp"
+
+class AudioSpectrumEffect : public AbstractEffect, public Singleton<AudioSpectrumEffect> {
+  public:
+	inline static const std::string AUDIO_FILE_ENV = "ROG_PERF_TUNER_AUDIO_FILE";
+
+  protected:
+	void prepare(const DeviceList& devices, const GeometryIndex& geometry) override;
+	void tick(const FrameTime& time) override;
+	void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) override;
+	void finish() override;
+
+  private:
+	struct DeviceMap {
+		std::vector<int32_t> bands;
+		std::vector<float> rows;
+		float height = 1;
+	};
+
+	friend class Singleton<AudioSpectrumEffect>;
+	AudioSpectrumEffect();
+
+	double _fall = 1.5;
+	AudioCapture _capture;
+	std::vector<float> _input;
+	std::vector<float> _levels;
+	std::vector<Color> _colors;
+	std::vector<DeviceMap> _maps;
+};
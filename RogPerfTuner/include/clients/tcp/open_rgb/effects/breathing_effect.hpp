@@ -5,15 +5,14 @@
 
 class BreathingEffect : public AbstractEffect, public Singleton<BreathingEffect> {
   public:
-	void apply_effect(const DeviceList& devices);
+	void tick(const FrameTime& time) override;
+	void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) override;
 
   private:
 	friend class Singleton<BreathingEffect>;
-	BreathingEffect(Client& client);
+	BreathingEffect();
 
 	double _total_time;
 	double _pause_time;
-	double _frequency;
-	int _step_count;
-	std::vector<double> _sin_steps;
-};
\ No newline at end of file
+	Color _current;
+};
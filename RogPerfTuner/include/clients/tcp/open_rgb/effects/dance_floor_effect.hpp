@@ -9,15 +9,18 @@
 class DanceFloorEffect : public AbstractEffect, public Singleton<DanceFloorEffect> {
   private:
 	friend class Singleton<DanceFloorEffect>;
-	std::mt19937 _rng;
+	double _interval	 = 0.5;
+	uint64_t _generation = 0;
+	std::vector<uint64_t> _rendered;
 
 	Color _get_random_color();
 
-	std::vector<Color> _get_random_colors(size_t length);
-
   public:
-	DanceFloorEffect(Client& client);
+	DanceFloorEffect();
 
   protected:
-	void apply_effect(const DeviceList& devices);
+	void prepare(const DeviceList& devices, const GeometryIndex& geometry) override;
+	void remap(const DeviceList& devices, const GeometryIndex& geometry, const std::vector<std::optional<size_t>>& previous) override;
+	void tick(const FrameTime& time) override;
+	void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) override;
 };
@@ -5,6 +5,7 @@
 
 #include "clients/tcp/open_rgb/effects/abstract/abstract_effect.hpp"
 #include "framework/abstracts/singleton.hpp"
+#include "framework/models/cpu_usage.hpp"
 
 class DigitalRainEffect : public AbstractEffect, public Singleton<DigitalRainEffect> {
   private:
@@ -19,13 +20,20 @@ class DigitalRainEffect : public AbstractEffect, public Singleton<DigitalRainEff
 		}
 	};
 
+	struct DeviceState {
+		std::vector<std::vector<LedStatus>> matrix;
+		double until_next = 0;
+	};
+
 	int _max_count	 = 15;
 	double _cpu		 = 0.0;
 	double _nap_time = 0.07;
+	double _next_cpu = 0;
+	CPUUsage _last_cpu;
 	std::vector<double> _sin_array;
-	std::mt19937 _rng;
+	std::vector<DeviceState> _states;
 
-	std::vector<std::vector<LedStatus>> _dev_to_mat(Device& dev);
+	std::vector<std::vector<LedStatus>> _dev_to_mat(const Device& dev, size_t devIdx, const GeometryIndex& geometry);
 
 	void _decrement_matrix(std::vector<std::vector<LedStatus>>& zone_status);
 
@@ -33,17 +41,16 @@ class DigitalRainEffect : public AbstractEffect, public Singleton<DigitalRainEff
 
 	void _get_next_matrix(std::vector<std::vector<LedStatus>>& zone_status);
 
-	std::vector<Color> _to_color_matrix(const std::vector<std::vector<LedStatus>>& zone_status, int dev_size);
-
-	void device_thread(Device& dev);
-
-	void cpu_thread();
+	void _to_color_matrix(const std::vector<std::vector<LedStatus>>& zone_status, std::span<Color> colors);
 
 	friend class Singleton<DigitalRainEffect>;
 
   public:
-	DigitalRainEffect(Client& client);
+	DigitalRainEffect();
 
   protected:
-	void apply_effect(const DeviceList& devices);
+	void prepare(const DeviceList& devices, const GeometryIndex& geometry) override;
+	void remap(const DeviceList& devices, const GeometryIndex& geometry, const std::vector<std::optional<size_t>>& previous) override;
+	void tick(const FrameTime& time) override;
+	void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) override;
 };
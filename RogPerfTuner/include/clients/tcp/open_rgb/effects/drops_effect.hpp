@@ -8,7 +8,9 @@
 
 class DropsEffect : public AbstractEffect, public Singleton<DropsEffect> {
   public:
-	void apply_effect(const DeviceList& devices);
+	void prepare(const DeviceList& devices, const GeometryIndex& geometry) override;
+	void remap(const DeviceList& devices, const GeometryIndex& geometry, const std::vector<std::optional<size_t>>& previous) override;
+	void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) override;
 
   private:
 	struct LedTask {
@@ -17,16 +19,13 @@ class DropsEffect : public AbstractEffect, public Singleton<DropsEffect> {
 	};
 
 	friend class Singleton<DropsEffect>;
-	DropsEffect(Client& client);
+	DropsEffect();
 
-	void _effect_thread(size_t dev_index, Device& dev);
+	LedTask _get_next(size_t dev_index, const Device& dev);
 
-	LedTask _get_next(size_t dev_index, Device& dev);
-
-	static int random_int(int min, int max);
-
-	static inline std::mt19937 rng{std::random_device{}()};
+	int random_int(int min, int max);
 
 	std::vector<Color> _available_colors;
 	std::vector<std::vector<LedTask>> _buffer;
+	std::vector<double> _until_next;
 };
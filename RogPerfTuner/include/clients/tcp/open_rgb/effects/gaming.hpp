@@ -10,12 +10,23 @@ class GamingEffect : public AbstractEffect, public Singleton<GamingEffect> {
   private:
 	friend class Singleton<GamingEffect>;
 
+	std::vector<std::vector<Color>> _layouts;
+
   public:
 	static const Color MAIN_COLOR;
 
 	static const std::vector<std::pair<std::regex, Color>> COLOR_MATCHING;
 
-	GamingEffect(Client& client);
+	GamingEffect();
+
+	void prepare(const DeviceList& devices, const GeometryIndex& geometry) override;
+
+	void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) override;
 
-	void apply_effect(const DeviceList& devices);
-};
\ No newline at end of file
+	/**
+	 * @brief Gets the base color, key highlights are only shown when rendered per LED.
+	 *
+	 * @return The base color.
+	 */
+	std::optional<Color> getSolidColor() override;
+};
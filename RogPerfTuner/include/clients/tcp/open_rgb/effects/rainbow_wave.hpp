@@ -1,13 +1,20 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "clients/tcp/open_rgb/effects/abstract/abstract_effect.hpp"
 #include "framework/abstracts/singleton.hpp"
 
 class RainbowWave : public AbstractEffect, public Singleton<RainbowWave> {
   public:
-	void apply_effect(const DeviceList& devices);
+	void prepare(const DeviceList& devices, const GeometryIndex& geometry) override;
+	void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) override;
 
   private:
 	friend class Singleton<RainbowWave>;
-	RainbowWave(Client& client);
+	RainbowWave();
+
+	double _speed = 90.0;
+	std::vector<std::vector<int32_t>> _hues;
 };
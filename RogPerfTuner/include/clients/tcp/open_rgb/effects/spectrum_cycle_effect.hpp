@@ -5,9 +5,13 @@
 
 class SpectrumCycleEffect : public AbstractEffect, public Singleton<SpectrumCycleEffect> {
   protected:
-	void apply_effect(const DeviceList& devices);
+	void tick(const FrameTime& time) override;
+	void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) override;
 
   private:
 	friend class Singleton<SpectrumCycleEffect>;
-	SpectrumCycleEffect(Client& client);
+	SpectrumCycleEffect();
+
+	double _cycle_time = 7.2;
+	Color _current;
 };
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <random>
-#include <thread>
 #include <vector>
 
 #include "clients/tcp/open_rgb/effects/abstract/abstract_effect.hpp"
@@ -9,17 +8,24 @@
 
 class StarryNightEffect : public AbstractEffect, public Singleton<StarryNightEffect> {
   private:
+	struct DeviceState {
+		std::vector<Color> leds;
+		std::vector<int> steps;
+		double until_next = 0;
+	};
+
 	friend class Singleton<StarryNightEffect>;
 	int _max_steps = 30;
-	std::vector<std::thread> _threads;
-	std::mt19937 _rng{std::random_device{}()};
+	std::vector<DeviceState> _states;
 
 	Color _get_random();
 
-	void _device_effect(Device& device);
+	void _step(DeviceState& state);
 
-	StarryNightEffect(Client& client);
+	StarryNightEffect();
 
   protected:
-	void apply_effect(const DeviceList& devices);
+	void prepare(const DeviceList& devices, const GeometryIndex& geometry) override;
+	void remap(const DeviceList& devices, const GeometryIndex& geometry, const std::vector<std::optional<size_t>>& previous) override;
+	void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) override;
 };
@@ -5,9 +5,11 @@
 
 class StaticEffect : public AbstractEffect, public Singleton<StaticEffect> {
   public:
-	void apply_effect(const DeviceList& devices);
+	void render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) override;
+
+	std::optional<Color> getSolidColor() override;
 
   private:
 	friend class Singleton<StaticEffect>;
-	StaticEffect(Client& client);
-};
\ No newline at end of file
+	StaticEffect();
+};
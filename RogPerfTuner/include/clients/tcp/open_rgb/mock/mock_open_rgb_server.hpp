@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "OpenRGB/Client.hpp"
+#include "framework/abstracts/loggable.hpp"
+
+/**
+ * @brief Local stand-in for the OpenRGB server, for measuring the lighting stack without hardware.
+ *
+ * Speaks the SDK protocol with synthetic devices: it answers the handshake and the device list requests,
+ * records every update packet it receives and keeps the last colors of each device.
+ */
+class MockOpenRgbServer : public Loggable {
+  public:
+	inline static const uint32_t PROTOCOL_VERSION = 3;
+
+	/**
+	 * @brief Layout of a synthetic device, a single matrix zone if it has rows or a single linear zone otherwise.
+	 */
+	struct DeviceSpec {
+		std::string name;
+		orgb::DeviceType type = orgb::DeviceType::Unknown;
+		uint32_t rows		  = 0;
+		uint32_t columns	  = 0;
+	};
+
+	struct Stats {
+		uint64_t packets	 = 0;
+		uint64_t bytes		 = 0;
+		uint64_t fullPackets = 0;
+		uint64_t zonePackets = 0;
+		uint64_t ledPackets	 = 0;
+	};
+
+	/**
+	 * @brief Parses a device layout list.
+	 *
+	 * @param spec Comma separated devices as type:columns or type:rowsxcolumns, e.g. "keyboard:6x22,mouse:3,strip:60".
+	 * @return One spec per device, unknown types are kept with DeviceType::Unknown.
+	 */
+	static std::vector<DeviceSpec> parseSpecs(const std::string& spec);
+
+	MockOpenRgbServer(const std::vector<DeviceSpec>& specs);
+	~MockOpenRgbServer();
+
+	/**
+	 * @brief Starts listening on a free localhost port.
+	 *
+	 * @return The port.
+	 */
+	int start();
+
+	/**
+	 * @brief Closes every connection and stops listening.
+	 */
+	void stop();
+
+	/**
+	 * @brief Gets the packets received since the last reset.
+	 *
+	 * @return A copy of the statistics.
+	 */
+	Stats getStats();
+
+	/**
+	 * @brief Clears the packet statistics.
+	 */
+	void resetStats();
+
+	/**
+	 * @brief Gets the last colors received for a device.
+	 *
+	 * @param devIdx Index of the device in the spec list.
+	 * @return One color per LED.
+	 */
+	std::vector<orgb::Color> getColors(size_t devIdx);
+
+  private:
+	inline static const uint32_t REQUEST_CONTROLLER_COUNT = 0;
+	inline static const uint32_t REQUEST_CONTROLLER_DATA  = 1;
+	inline static const uint32_t REQUEST_PROTOCOL_VERSION = 40;
+	inline static const uint32_t DEVICE_LIST_UPDATED	  = 100;
+	inline static const uint32_t REQUEST_RESCAN_DEVICES	  = 140;
+	inline static const uint32_t UPDATE_LEDS			  = 1050;
+	inline static const uint32_t UPDATE_ZONE_LEDS		  = 1051;
+	inline static const uint32_t UPDATE_SINGLE_LED		  = 1052;
+
+	std::vector<DeviceSpec> _specs;
+	std::vector<std::vector<orgb::Color>> _colors;
+	std::atomic<bool> _running = false;
+	int _listenFd			   = -1;
+	std::thread _acceptThread;
+	std::vector<std::thread> _clientThreads;
+	std::vector<int> _clientFds;
+	std::mutex _mutex;
+	Stats _stats;
+
+	void acceptLoop();
+	void clientLoop(int fd);
+	bool reply(int fd, uint32_t devIdx, uint32_t packetId, const std::string& body);
+	std::string controllerData(size_t devIdx, uint32_t version);
+	void storeColors(size_t devIdx, size_t offset, const char* data, size_t count);
+};
@@ -1,8 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+
 #include "OpenRGB/Client.hpp"
 #include "clients/shell/asusctl_client.hpp"
 #include "clients/tcp/open_rgb/effects/abstract/abstract_effect.hpp"
+#include "clients/tcp/open_rgb/render/render_engine.hpp"
 #include "models/hardware/usb_identifier.hpp"
 #include "utils/constants.hpp"
 #include "utils/event_bus_wrapper.hpp"
@@ -36,8 +43,8 @@ class OpenRgbClient : public Singleton<OpenRgbClient>, Loggable {
 	/**
 	 * @brief Initializes the OpenRGB client.
 	 *
-	 * This method sets up the necessary resources and establishes any required
-	 * connections for the OpenRGB client to function properly.
+	 * This method sets up the necessary resources and starts the OpenRGB server in the background.
+	 * Effects applied before the server has finished detecting devices are rendered once it does.
 	 *
 	 * @note Must be called before performing any operations with the client.
 	 */
@@ -59,6 +66,15 @@ class OpenRgbClient : public Singleton<OpenRgbClient>, Loggable {
 	 * server are closed.
 	 */
 	void stop();
+	/**
+	 * @brief Asks the running OpenRGB server to rescan and attaches the new devices to the current effect.
+	 *
+	 * The server and the connection are kept, devices already known keep their lighting and only
+	 * the new ones are switched to direct mode.
+	 *
+	 * @return true if the device list was refreshed, false if the server didn't report an update in time.
+	 */
+	bool rescanDevices();
 	/**
 	 * @brief Disables the specified device.
 	 *
@@ -85,15 +101,59 @@ class OpenRgbClient : public Singleton<OpenRgbClient>, Loggable {
 	 * @return std::optional<std::string> The current color as a string, or std::nullopt if unavailable.
 	 */
 	const std::optional<std::string> getColor();
+	/**
+	 * @brief Sets the frame rate used to render the effects.
+	 *
+	 * @param fps Frames per second.
+	 */
+	void setFps(uint32_t fps);
+	/**
+	 * @brief Sets the gamma and white balance correction of each device.
+	 *
+	 * @param corrections Corrections by device name.
+	 */
+	void setCorrections(const std::map<std::string, RgbCorrection>& corrections);
+	/**
+	 * @brief Retrieves the governor that adapts the frame rate to games, profile and power source.
+	 *
+	 * @return FpsGovernor& The governor of the render loop.
+	 */
+	FpsGovernor& getFpsGovernor();
+	/**
+	 * @brief Retrieves the statistics of the effect being rendered.
+	 *
+	 * @return RenderEngine::Stats Frame and send statistics since the effect started.
+	 */
+	RenderEngine::Stats getRenderStats();
 
   private:
 	friend class Singleton<OpenRgbClient>;
+	inline static const uint32_t RESCAN_PACKET_ID = 140;
+	inline static const int RESCAN_TIMEOUT_MS	  = 10000;
+	inline static const int RESCAN_SETTLE_MS	  = 500;
+	inline static const int RESCAN_POLL_MS		  = 50;
+	inline static const int CONNECT_TIMEOUT_MS	  = 30000;
+	inline static const int CONNECT_RETRY_MS	  = 10;
+	inline static const int CONNECT_MAX_RETRY_MS  = 500;
+
 	std::unordered_map<std::string, std::string> compatibleDeviceNames;
 	std::thread runnerThread;
+	std::thread starter;
+	std::mutex mutex;
+	std::condition_variable rescanDone;
+	std::atomic<bool> started		= false;
+	bool ready						= false;
+	bool rescanning					= false;
+	bool builtInOnly				= false;
+	RgbBrightness currentBrightness	= RgbBrightness::MAX;
+	std::optional<RgbBrightness> pendingBrightness;
+	std::vector<std::string> deviceSnapshot;
 	int port  = 0;
 	pid_t pid = 0;
 	orgb::Client client{Constants::APP_NAME};
 	orgb::DeviceList detectedDevices;
+	GeometryIndex geometry;
+	RenderEngine renderEngine{client};
 	std::vector<std::unique_ptr<AbstractEffect>> availableEffects;
 	std::thread udevConfigurer;
 	std::vector<UsbIdentifier> compatibleDevices;
@@ -111,6 +171,16 @@ class OpenRgbClient : public Singleton<OpenRgbClient>, Loggable {
 	void startOpenRgbClient();
 	void stopOpenRgbProcess();
 	void getAvailableDevices();
+	void setupDevice(const orgb::Device& dev);
+	void startAsync();
+	void abortStart();
+	bool canUseAura();
+	void applyAura(AbstractEffect& effect, const RgbBrightness& brightness);
+	void loadDeviceSnapshot();
+	void saveDeviceSnapshot();
+	static std::string deviceKey(const orgb::Device& dev);
+	bool requestRescan();
+	bool waitForDeviceUpdate();
 	void configureUdev();
 	void runner();
 };
\ No newline at end of file
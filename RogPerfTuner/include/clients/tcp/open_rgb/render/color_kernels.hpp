@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "OpenRGB/Color.hpp"
+
+using orgb::Color;
+
+/**
+ * @brief Per device lookup tables combining brightness, gamma and white balance.
+ */
+struct ColorCorrection {
+	std::array<uint8_t, 256> r;
+	std::array<uint8_t, 256> g;
+	std::array<uint8_t, 256> b;
+	uint16_t factor = 256;
+	bool linear		= true;
+
+	/**
+	 * @brief Builds the correction tables.
+	 *
+	 * @param brightness Brightness factor in [0, 1].
+	 * @param gamma Gamma exponent, 1 for none.
+	 * @param white Color rendered for full white.
+	 * @return The correction tables.
+	 */
+	static ColorCorrection build(double brightness, double gamma = 1.0, Color white = Color(255, 255, 255));
+
+	/**
+	 * @brief Applies the correction to a buffer.
+	 *
+	 * @param in Source colors.
+	 * @param out Destination colors, same size as the source.
+	 */
+	void apply(std::span<const Color> in, std::span<Color> out) const;
+};
+
+class ColorKernels {
+  public:
+	/**
+	 * @brief Number of entries of the hue table, a quarter of a degree each.
+	 */
+	inline static const size_t HUE_STEPS = 1440;
+
+	/**
+	 * @brief Gets the index in the hue table of an angle.
+	 *
+	 * @param degrees Hue in degrees, any value is wrapped to [0, 360).
+	 * @return Index in [0, HUE_STEPS).
+	 */
+	static size_t hueIndex(double degrees);
+
+	/**
+	 * @brief Gets a fully saturated color from the hue table.
+	 *
+	 * @param index Index in the hue table, wrapped to HUE_STEPS.
+	 * @return The color.
+	 */
+	static Color hueAt(size_t index);
+
+	/**
+	 * @brief Gets a fully saturated color from the hue table.
+	 *
+	 * @param degrees Hue in degrees.
+	 * @return The color.
+	 */
+	static Color hue(double degrees);
+
+	/**
+	 * @brief Converts an HSV triplet using the hue table.
+	 *
+	 * @param degrees Hue in degrees.
+	 * @param saturation Saturation in [0, 1].
+	 * @param value Value in [0, 1].
+	 * @return The color.
+	 */
+	static Color hsv(double degrees, double saturation, double value);
+
+	/**
+	 * @brief Scales a color with fixed point arithmetic.
+	 *
+	 * @param color The color.
+	 * @param factor Factor in [0, 1].
+	 * @return The scaled color.
+	 */
+	static Color scale(Color color, double factor);
+
+	/**
+	 * @brief Scales a buffer with fixed point arithmetic.
+	 *
+	 * The loop has no branches so the compiler can vectorise it.
+	 *
+	 * @param in Source colors.
+	 * @param out Destination colors, same size as the source.
+	 * @param factor Factor in 1/256 units, 256 keeps the colors unchanged.
+	 */
+	static void scale(std::span<const Color> in, std::span<Color> out, uint16_t factor);
+
+	/**
+	 * @brief Converts a factor in [0, 1] to 1/256 units.
+	 *
+	 * @param factor The factor.
+	 * @return The fixed point factor.
+	 */
+	static uint16_t toFixed(double factor);
+};
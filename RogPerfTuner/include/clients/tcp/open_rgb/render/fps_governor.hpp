@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "framework/abstracts/loggable.hpp"
+
+class FpsGovernor : public Loggable {
+  public:
+	inline static const uint32_t MIN_FPS = 1;
+	inline static const uint32_t MAX_FPS = 120;
+
+	FpsGovernor(uint32_t maxFps);
+
+	/**
+	 * @brief Sets the frame rate used when nothing asks for throttling.
+	 *
+	 * @param fps Frames per second, clamped between MIN_FPS and MAX_FPS.
+	 */
+	void setMaxFps(uint32_t fps);
+
+	/**
+	 * @brief Gets the frame rate used when nothing asks for throttling.
+	 *
+	 * @return Frames per second.
+	 */
+	uint32_t getMaxFps();
+
+	/**
+	 * @brief Sets if there are games running.
+	 *
+	 * @param gaming true while at least one game is running.
+	 */
+	void setGaming(bool gaming);
+
+	/**
+	 * @brief Sets if the applied performance profile is the quiet one.
+	 *
+	 * @param quiet true while QUIET is applied, either selected or chosen by SMART.
+	 */
+	void setQuiet(bool quiet);
+
+	/**
+	 * @brief Sets if the laptop is running on battery.
+	 *
+	 * @param onBattery true while unplugged.
+	 */
+	void setOnBattery(bool onBattery);
+
+	/**
+	 * @brief Computes the frame rate for an effect under the current conditions.
+	 *
+	 * Every active condition halves the frame rate, which never goes below the effect minimum
+	 * nor above its maximum.
+	 *
+	 * @param effectMin Lowest frame rate at which the effect still looks smooth.
+	 * @param effectMax Highest frame rate the effect can take advantage of.
+	 * @return Frames per second.
+	 */
+	uint32_t target(uint32_t effectMin, uint32_t effectMax);
+
+  private:
+	std::atomic<uint32_t> _maxFps;
+	std::atomic<bool> _gaming	 = false;
+	std::atomic<bool> _quiet	 = false;
+	std::atomic<bool> _onBattery = false;
+};
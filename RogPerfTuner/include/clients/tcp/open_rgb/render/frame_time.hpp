@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Timing information handed to effects on every rendered frame.
+ */
+struct FrameTime {
+	/** Index of the frame since the effect started. */
+	uint64_t frame = 0;
+	/** Seconds elapsed since the effect started. */
+	double elapsed = 0;
+	/** Seconds elapsed since the previous render of the same device. */
+	double delta = 0;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "OpenRGB/Client.hpp"
+
+/**
+ * @brief Position of every LED of a device list, computed once per list.
+ *
+ * Every device is laid out as a grid, one row per linear zone and one per matrix row, and placed
+ * next to the previous one in a virtual canvas proportionally to its number of columns. All data
+ * is stored in flat arrays indexed by device offset plus LED index.
+ */
+class GeometryIndex {
+  public:
+	inline static const uint32_t NO_LED = 0xFFFFFFFF;
+
+	struct DeviceGeometry {
+		size_t first	 = 0;
+		size_t leds		 = 0;
+		size_t gridStart = 0;
+		uint32_t rows	 = 0;
+		uint32_t columns = 0;
+	};
+
+	/**
+	 * @brief Rebuilds the index for a device list.
+	 *
+	 * @param devices The devices, in the order used by the render engine.
+	 */
+	void build(const orgb::DeviceList& devices);
+
+	/**
+	 * @brief Gets the number of devices indexed.
+	 *
+	 * @return Number of devices.
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Gets the grid size and offsets of a device.
+	 *
+	 * @param devIdx Index of the device.
+	 * @return The device geometry.
+	 */
+	const DeviceGeometry& device(size_t devIdx) const;
+
+	/**
+	 * @brief Gets the horizontal position of every LED inside its row, in [0, 1).
+	 *
+	 * @param devIdx Index of the device.
+	 * @return One value per LED, negative for LEDs outside any layout.
+	 */
+	std::span<const float> x(size_t devIdx) const;
+
+	/**
+	 * @brief Gets the vertical position of every LED inside its device, in [0, 1), shared by the canvas.
+	 *
+	 * @param devIdx Index of the device.
+	 * @return One value per LED, negative for LEDs outside any layout.
+	 */
+	std::span<const float> y(size_t devIdx) const;
+
+	/**
+	 * @brief Gets the horizontal position of every LED in the canvas spanning all devices, in [0, 1).
+	 *
+	 * @param devIdx Index of the device.
+	 * @return One value per LED, negative for LEDs outside any layout.
+	 */
+	std::span<const float> canvasX(size_t devIdx) const;
+
+	/**
+	 * @brief Gets the LED at a grid cell.
+	 *
+	 * @param devIdx Index of the device.
+	 * @param row Row of the grid.
+	 * @param column Column of the grid.
+	 * @return Index of the LED in the device, or NO_LED for empty cells.
+	 */
+	uint32_t at(size_t devIdx, uint32_t row, uint32_t column) const;
+
+  private:
+	std::vector<DeviceGeometry> _devices;
+	std::vector<float> _x;
+	std::vector<float> _y;
+	std::vector<float> _canvasX;
+	std::vector<uint32_t> _grid;
+};
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "clients/tcp/open_rgb/effects/abstract/abstract_effect.hpp"
+#include "clients/tcp/open_rgb/render/color_kernels.hpp"
+#include "clients/tcp/open_rgb/render/fps_governor.hpp"
+#include "framework/abstracts/loggable.hpp"
+#include "models/hardware/rgb_brightness.hpp"
+#include "models/settings/rgb_correction.hpp"
+
+class RenderEngine : public Loggable {
+  public:
+	inline static const uint32_t DEFAULT_FPS = 30;
+	inline static const uint32_t MIN_FPS	 = FpsGovernor::MIN_FPS;
+	inline static const uint32_t MAX_FPS	 = FpsGovernor::MAX_FPS;
+
+	struct Stats {
+		uint64_t frames		 = 0;
+		uint64_t lateFrames	 = 0;
+		uint64_t sends		 = 0;
+		uint64_t skipped	 = 0;
+		uint64_t ledPackets	 = 0;
+		uint64_t zonePackets = 0;
+		uint64_t fullPackets = 0;
+		double avgFrameMs	 = 0;
+		double maxFrameMs	 = 0;
+		double avgSendMs	 = 0;
+		uint32_t slowDevices = 0;
+		uint32_t fps		 = 0;
+		double cpuMs		 = 0;
+		double cpuLoad		 = 0;
+		double jitterMs		 = 0;
+	};
+
+	RenderEngine(Client& client);
+	~RenderEngine();
+
+	/**
+	 * @brief Starts rendering an effect on the given devices.
+	 *
+	 * Any running effect is stopped first. With OFF brightness the devices are turned black and nothing is rendered.
+	 *
+	 * @param effect The effect to render.
+	 * @param devices The devices to render on, must outlive the rendering.
+	 * @param geometry Position of the LEDs of the devices, must outlive the rendering.
+	 * @param brightness The brightness applied to every frame.
+	 */
+	void start(AbstractEffect& effect, const DeviceList& devices, const GeometryIndex& geometry, const RgbBrightness& brightness);
+
+	/**
+	 * @brief Changes the brightness of the effect being rendered without restarting it.
+	 *
+	 * The change is picked up on the next frame. Color changes made on the effect itself are picked up the same way.
+	 *
+	 * @param effect The effect the change is meant for.
+	 * @param brightness The new brightness.
+	 * @return true if the effect is being rendered and was updated, false if it has to be started instead.
+	 */
+	bool update(AbstractEffect& effect, const RgbBrightness& brightness);
+
+	/**
+	 * @brief Stops the render thread, leaving the devices with their last frame.
+	 */
+	void stop();
+
+	/**
+	 * @brief Stops the render thread so the device list can be replaced, remembering if an effect was running.
+	 */
+	void pause();
+
+	/**
+	 * @brief Resumes the paused effect on a new device list.
+	 *
+	 * The effect keeps its clock. Devices present before the pause keep their last frame and effect state, and only changed LEDs are
+	 * sent to them.
+	 *
+	 * @param devices The devices to render on, must outlive the rendering.
+	 * @param geometry Position of the LEDs of the devices, must outlive the rendering.
+	 */
+	void resume(const DeviceList& devices, const GeometryIndex& geometry);
+
+	/**
+	 * @brief Checks if an effect is being rendered.
+	 *
+	 * @return true if the render thread is running, false otherwise.
+	 */
+	bool isRunning();
+
+	/**
+	 * @brief Sets the highest frame rate of the render loop.
+	 *
+	 * @param fps Frames per second, clamped between MIN_FPS and MAX_FPS.
+	 */
+	void setFps(uint32_t fps);
+
+	/**
+	 * @brief Gets the highest frame rate of the render loop.
+	 *
+	 * @return Frames per second.
+	 */
+	uint32_t getFps();
+
+	/**
+	 * @brief Gets the governor that lowers the frame rate under load or on battery.
+	 *
+	 * @return The governor.
+	 */
+	FpsGovernor& getGovernor();
+
+	/**
+	 * @brief Sets the gamma and white balance correction of each device.
+	 *
+	 * Takes effect the next time an effect is started.
+	 *
+	 * @param corrections Corrections by device name, devices not present are left uncorrected.
+	 */
+	void setCorrections(const std::map<std::string, RgbCorrection>& corrections);
+
+	/**
+	 * @brief Gets the statistics of the current run.
+	 *
+	 * @return A copy of the statistics.
+	 */
+	Stats getStats();
+
+  private:
+	using Clock = std::chrono::steady_clock;
+
+	inline static const double STATS_INTERVAL = 60.0;
+
+	// Rough wire cost of each OpenRGB packet in bytes, per packet overhead includes the server side device update
+	inline static const size_t PACKET_COST	= 64;
+	inline static const size_t HEADER_BYTES = 16;
+	inline static const size_t COLOR_BYTES	= 4;
+
+	struct ZoneSpan {
+		const orgb::Zone* zone = nullptr;
+		size_t start		   = 0;
+		size_t count		   = 0;
+	};
+
+	struct DeviceSlot {
+		const Device* device = nullptr;
+		std::string key;
+		std::vector<Color> front;
+		std::vector<Color> back;
+		std::vector<Color> out;
+		std::vector<ZoneSpan> zones;
+		std::vector<size_t> changed;
+		std::vector<size_t> changedPerZone;
+		std::vector<bool> wholeZone;
+		ColorCorrection correction;
+		Clock::time_point lastRender;
+		double sendCostMs = 0;
+		uint32_t divider  = 1;
+		uint32_t counter  = 0;
+		bool sent		  = false;
+	};
+
+	Client& _client;
+	AbstractEffect* _effect		   = nullptr;
+	const DeviceList* _devices	   = nullptr;
+	const GeometryIndex* _geometry = nullptr;
+	std::vector<DeviceSlot> _slots;
+	FpsGovernor _governor{DEFAULT_FPS};
+	std::atomic<bool> _running			= false;
+	bool _resume						= false;
+	// Previous index of every device when resuming, the effect is remapped instead of prepared again
+	std::optional<std::vector<std::optional<size_t>>> _remap;
+	std::atomic<bool> _dirty			= false;
+	std::atomic<int> _pendingBrightness	= -1;
+	Clock::time_point _startTime;
+	uint64_t _frame	   = 0;
+	double _brightness = 1;
+	std::map<std::string, RgbCorrection> _corrections;
+	std::thread _thread;
+	std::mutex _mutex;
+	std::mutex _waitMutex;
+	std::mutex _statsMutex;
+	std::condition_variable _cv;
+	Stats _stats;
+
+	void stopThread();
+	DeviceSlot buildSlot(const Device& dev);
+	ColorCorrection buildCorrection(const Device& dev);
+	void loop();
+	void applyPending();
+	void renderFrame(const FrameTime& time, Clock::time_point now, double period);
+	void send(DeviceSlot& slot, double period);
+	void transmit(DeviceSlot& slot);
+	void sendFull(DeviceSlot& slot);
+	void logStats(bool debug);
+};
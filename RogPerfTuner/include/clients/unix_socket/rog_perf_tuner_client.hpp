@@ -18,5 +18,13 @@ class RogPerfTunerClient : public AbstractUnixSocketClient, public Singleton<Rog
 
 	void showGui();
 
+	/**
+	 * @brief Asks the running instance to write its trace.
+	 *
+	 * @param path Destination file.
+	 * @return Summary of the written trace.
+	 */
+	std::string exportTrace(const std::string& path);
+
 	SteamGameConfig getGameConfig(const std::string& steamId);
 };
\ No newline at end of file
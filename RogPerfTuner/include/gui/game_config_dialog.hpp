@@ -30,6 +30,7 @@ class GameConfigDialog : public QDialog, Loggable {
 
 	NoScrollComboBox* gpuCombo;
 	NoScrollComboBox* schedulerCombo;
+	NoScrollComboBox* ioPresetCombo;
 	NoScrollComboBox* modeCombo;
 	NoScrollComboBox* metricsCombo;
 	NoScrollComboBox* wineSyncCombo;
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <map>
+
+#include "clients/tcp/open_rgb/effects/audio_spectrum_effect.hpp"
+#include "clients/tcp/open_rgb/effects/breathing_effect.hpp"
+#include "clients/tcp/open_rgb/effects/dance_floor_effect.hpp"
+#include "clients/tcp/open_rgb/effects/digital_rain_effect.hpp"
+#include "clients/tcp/open_rgb/effects/drops_effect.hpp"
+#include "clients/tcp/open_rgb/effects/gaming.hpp"
+#include "clients/tcp/open_rgb/effects/rainbow_wave.hpp"
+#include "clients/tcp/open_rgb/effects/spectrum_cycle_effect.hpp"
+#include "clients/tcp/open_rgb/effects/starry_night_effect.hpp"
+#include "clients/tcp/open_rgb/effects/static_effect.hpp"
+#include "clients/tcp/open_rgb/mock/mock_open_rgb_server.hpp"
+#include "clients/tcp/open_rgb/render/render_engine.hpp"
+#include "framework/logger/logger_provider.hpp"
+#include "framework/utils/file_utils.hpp"
+#include "framework/utils/string_utils.hpp"
+#include "framework/utils/time_utils.hpp"
+#include "main/socket.hpp"
+#include "models/others/app_options.hpp"
+#include "utils/constants.hpp"
+
+inline const std::string BENCHMARK_DEVICES = "keyboard:6x22,mouse:3,strip:60";
+inline const int BENCHMARK_MS			   = 5000;
+inline const uint32_t GOLDEN_SEED		   = 1234;
+inline const uint64_t GOLDEN_FRAMES		   = 300;
+inline const int HOTKEY_ITERATIONS		   = 50;
+
+/**
+ * @brief Renders a fixed number of frames with a fixed seed and clock and hashes them.
+ */
+inline uint64_t renderGolden(AbstractEffect& effect, const DeviceList& devices, const GeometryIndex& geometry) {
+	effect.setSeed(GOLDEN_SEED);
+	effect.reseed();
+	effect.prepare(devices, geometry);
+
+	std::vector<std::vector<Color>> buffers;
+	for (auto& dev : devices) {
+		buffers.emplace_back(dev.leds.size(), Color::Black);
+	}
+
+	// FNV-1a over every rendered color
+	uint64_t hash = 14695981039346656037ULL;
+	for (uint64_t frame = 0; frame < GOLDEN_FRAMES; frame++) {
+		FrameTime time{frame, frame / 30.0, 1 / 30.0};
+		effect.tick(time);
+		for (size_t i = 0; i < devices.size(); i++) {
+			effect.render(time, devices[i], i, buffers[i]);
+			for (auto& color : buffers[i]) {
+				for (auto channel : {color.r, color.g, color.b}) {
+					hash = (hash ^ channel) * 1099511628211ULL;
+				}
+			}
+		}
+	}
+
+	effect.finish();
+	effect.setSeed(std::nullopt);
+	return hash;
+}
+
+/**
+ * @brief Runs every effect against a mock OpenRGB server and reports throughput and golden frame checks.
+ *
+ * Devices are taken from ROG_PERF_TUNER_MOCK_DEVICES, see MockOpenRgbServer::parseSpecs(). Golden hashes are
+ * compared with the given file, effects missing from it are appended. A mismatch or an effect that doesn't
+ * render the same frames twice fails the run.
+ */
+inline int runRgbBenchmark(int argc, char** argv) {
+	LoggerProvider::initialize();
+
+	auto env   = std::getenv("ROG_PERF_TUNER_MOCK_DEVICES");
+	auto specs = MockOpenRgbServer::parseSpecs(env != nullptr ? env : BENCHMARK_DEVICES);
+	MockOpenRgbServer server(specs);
+	auto port = server.start();
+
+	orgb::Client client(Constants::APP_NAME);
+	if (client.connect("localhost", port) != orgb::ConnectStatus::Success) {
+		std::cerr << "Couldn't connect to mock server" << std::endl;
+		return 1;
+	}
+	auto devices = client.requestDeviceList().devices;
+	GeometryIndex geometry;
+	geometry.build(devices);
+
+	std::vector<AbstractEffect*> effects = {&AudioSpectrumEffect::getInstance(), &BreathingEffect::getInstance(),
+											&DanceFloorEffect::getInstance(),	 &DigitalRainEffect::getInstance(),
+											&DropsEffect::getInstance(),		 &GamingEffect::getInstance(),
+											&RainbowWave::getInstance(),		 &SpectrumCycleEffect::getInstance(),
+											&StarryNightEffect::getInstance(),	 &StaticEffect::getInstance()};
+
+	RenderEngine engine(client);
+	engine.setFps(RenderEngine::MAX_FPS);
+
+	std::cout << std::format("{:<16}{:>8}{:>14}{:>14}{:>14}", "Effect", "FPS", "Bytes/frame", "CPU ms/frame", "Jitter ms") << std::endl;
+	for (auto effect : effects) {
+		server.resetStats();
+		engine.start(*effect, devices, geometry, RgbBrightness::MAX);
+		TimeUtils::sleep(BENCHMARK_MS);
+		engine.stop();
+
+		auto stats	= engine.getStats();
+		auto wire	= server.getStats();
+		auto frames = std::max<uint64_t>(stats.frames, 1);
+		std::cout << std::format("{:<16}{:>8.1f}{:>14.0f}{:>14.3f}{:>14.3f}", effect->getName(), stats.frames * 1000.0 / BENCHMARK_MS,
+								 static_cast<double>(wire.bytes) / frames, stats.cpuMs / frames, stats.jitterMs)
+				  << std::endl;
+	}
+	client.disconnect();
+	server.stop();
+
+	std::string goldenFile = argc > 1 ? argv[1] : "";
+	std::map<std::string, std::string> golden;
+	if (!goldenFile.empty() && FileUtils::exists(goldenFile)) {
+		for (auto& line : StringUtils::splitLines(FileUtils::readFileContent(goldenFile))) {
+			auto pos = line.find('\t');
+			if (pos != std::string::npos) {
+				golden[line.substr(0, pos)] = line.substr(pos + 1);
+			}
+		}
+	}
+
+	int result = 0;
+	std::string recorded;
+	std::cout << std::endl << std::format("{:<16}{:>18}  {}", "Effect", "Golden hash", "Check") << std::endl;
+	for (auto effect : effects) {
+		// Live audio can't be replayed, every other effect must render the same frames with the same seed
+		if (effect == &AudioSpectrumEffect::getInstance()) {
+			continue;
+		}
+
+		auto hash  = std::format("{:016x}", renderGolden(*effect, devices, geometry));
+		auto check = goldenFile.empty() ? "ok" : "recorded";
+		if (hash != std::format("{:016x}", renderGolden(*effect, devices, geometry))) {
+			check = "not deterministic";
+			result |= 1;
+		} else if (golden.contains(effect->getName())) {
+			check = golden[effect->getName()] == hash ? "match" : "MISMATCH";
+			result |= golden[effect->getName()] == hash ? 0 : 1;
+		} else {
+			recorded += effect->getName() + "\t" + hash + "\n";
+		}
+		std::cout << std::format("{:<16}{:>18}  {}", effect->getName(), hash, check) << std::endl;
+	}
+
+	// Hashes already in the file are kept as they were, only the new effects are added
+	if (!goldenFile.empty() && !recorded.empty()) {
+		std::string content = FileUtils::exists(goldenFile) ? FileUtils::readFileContent(goldenFile) : "";
+		if (!content.empty() && !content.ends_with('\n')) {
+			content += "\n";
+		}
+		FileUtils::writeFileContent(goldenFile, content + recorded);
+	}
+	return result;
+}
+
+/**
+ * @brief Calls the function the given number of times and prints the latency percentiles of a call.
+ */
+inline void measureHotkey(const std::string& name, int iterations, const std::function<void(int)>& call) {
+	std::vector<double> samples;
+	samples.reserve(iterations);
+	for (int i = 0; i < iterations; i++) {
+		auto start = std::chrono::steady_clock::now();
+		call(i);
+		samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	std::sort(samples.begin(), samples.end());
+	std::cout << std::format("{:<20}{:>10.3f}{:>10.3f}{:>10.3f}{:>10.3f}", name, samples.front(), samples[samples.size() / 2],
+							 samples[samples.size() * 95 / 100], samples.back())
+			  << std::endl;
+}
+
+/**
+ * @brief Runs this binary with a hotkey option, as the hotkey scripts do, and waits for it to finish.
+ */
+inline void spawnHotkey(AppOptions option) {
+	std::string exe = "/proc/self/exe";
+	auto arg		= getShortOption(option).value();
+	char* argv[]	= {exe.data(), arg.data(), nullptr};
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+
+	pid_t pid;
+	int status = 0;
+	auto err   = posix_spawn(&pid, exe.c_str(), &actions, nullptr, argv, environ);
+	posix_spawn_file_actions_destroy(&actions);
+	if (err != 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		throw std::runtime_error("Hotkey " + arg + " failed");
+	}
+}
+
+/**
+ * @brief Measures the latency from key press to applied change against the running instance.
+ *
+ * Brightness is increased and decreased alternately, so it ends where it started. The running instance answers
+ * once the change is applied, so each sample covers the whole key press. The request rows reuse this process,
+ * the hotkey row starts a new one on every sample as the hotkey scripts do.
+ */
+inline int runHotkeyBenchmark(int argc, char** argv) {
+	int iterations = argc > 1 ? std::atoi(argv[1]) : HOTKEY_ITERATIONS;
+	iterations	   = std::max(2, iterations - iterations % 2);
+
+	std::cout << std::format("{:<20}{:>10}{:>10}{:>10}{:>10}", "Latency ms", "Min", "P50", "P95", "Max") << std::endl;
+	try {
+		measureHotkey("ping", iterations, [](int) {
+			AbstractUnixSocketClient::invokeOnce(Constants::SOCKET_FILE, "ping", {}, HOTKEY_TIMEOUT_MS);
+		});
+		measureHotkey("brightness request", iterations, [](int i) {
+			auto method = i % 2 == 0 ? Constants::INC_BRIGHT : Constants::DEC_BRIGHT;
+			AbstractUnixSocketClient::invokeOnce(Constants::SOCKET_FILE, method, {}, HOTKEY_TIMEOUT_MS);
+		});
+		measureHotkey("brightness hotkey", iterations, [](int i) {
+			spawnHotkey(i % 2 == 0 ? AppOptions::incBrightness : AppOptions::decBrightness);
+		});
+	} catch (const std::exception& e) {
+		std::cerr << "Error while measuring hotkeys: " << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
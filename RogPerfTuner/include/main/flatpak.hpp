@@ -4,12 +4,14 @@
 #include <linux/prctl.h>
 #include <sys/prctl.h>
 #include <sys/wait.h>
+#include <unistd.h>
 
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "clients/shell/flatpak.hpp"
 #include "framework/logger/logger_provider.hpp"
@@ -31,18 +33,18 @@ inline int runFlatpakWrapping(int argc, char* argv[]) {
 	}
 	setenv("PATH", path.c_str(), 1);
 
-	std::string command;
+	std::vector<std::string> command;
 	if (getenv("ORIG_FLATPAK_BIN")) {
-		command = getenv("ORIG_FLATPAK_BIN");
+		command.push_back(getenv("ORIG_FLATPAK_BIN"));
 	} else {
-		auto whichResult = Shell::getInstance().which(std::string("flatpak"));
-		if (!whichResult.has_value()) {
+		auto whichResult = FileUtils::findInPath("flatpak");
+		if (whichResult.empty()) {
 			std::cerr << "Command " + std::string(argv[0]) + " not found" << std::endl;
 			exit(127);
 		}
-		command = whichResult.value();
+		command.push_back(whichResult[0]);
 	}
-	std::cout << "flatpak -> " + command << std::endl;
+	std::cout << "flatpak -> " + command[0] << std::endl;
 
 	bool isRun = false;
 	for (int i = 1; i < argc; i++) {
@@ -61,7 +63,7 @@ inline int runFlatpakWrapping(int argc, char* argv[]) {
 			while (std::getline(ss, token, ';')) {
 				const char* val = std::getenv(token.c_str());
 				if (val) {
-					command += " --env=" + token + "=" + val;
+					command.push_back("--env=" + token + "=" + val);
 					if (token == "MANGOHUD") {
 						mangohudRequested = true;
 					}
@@ -80,12 +82,22 @@ inline int runFlatpakWrapping(int argc, char* argv[]) {
 	}
 
 	for (int i = 1; i < argc; i++) {
-		command += " ";
-		command += argv[i];
+		command.push_back(argv[i]);
 	}
 
-	std::cout << ">>> Command:\n  " << command << std::endl;
-	int result = std::system(command.c_str());
+	std::vector<char*> args;
+	args.reserve(command.size() + 1);
+	std::ostringstream line;
+	for (auto& arg : command) {
+		args.push_back(const_cast<char*>(arg.c_str()));
+		line << " " << arg;
+	}
+	args.push_back(nullptr);
+
+	std::cout << ">>> Command:\n " << line.str() << std::endl;
+	LoggerProvider::flush();
+	execve(command[0].c_str(), args.data(), environ);
 
-	return WEXITSTATUS(result);
+	std::cerr << "Error on execve: " << std::strerror(errno) << std::endl;
+	return 127;
 }
\ No newline at end of file
@@ -176,6 +176,7 @@ inline int startGui(int argc, char** argv) {
 
 		int ret = msg.exec();
 
+		LoggerProvider::flush();
 		::_exit(1);
 	}
 
@@ -189,12 +190,13 @@ inline int startGui(int argc, char** argv) {
 
 	logger->info("Application ready after {} seconds", TimeUtils::format_seconds(TimeUtils::getTimeDiff(t0, TimeUtils::now())));
 
-	if (!configuration.getConfiguration().application.startMinimized) {
+	if (!configuration.getConfiguration()->application.startMinimized) {
 		MainWindow::getInstance().show();
 	}
 
 	EventBusWrapper::getInstance().onApplicationStop([&t0, &logger, &app]() {
 		logger->info("Application finished after {} seconds", TimeUtils::format_seconds(TimeUtils::getTimeDiff(t0, TimeUtils::now())));
+		LoggerProvider::flush();
 		::_exit(0);
 	});
 
@@ -5,19 +5,24 @@
 #include <sys/prctl.h>
 #include <sys/wait.h>
 
+#include <any>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 
-#include "clients/unix_socket/rog_perf_tuner_client.hpp"
+#include "framework/clients/abstract/abstract_unix_socket_client.hpp"
 #include "framework/logger/logger_provider.hpp"
-#include "framework/shell/shell.hpp"
 #include "framework/utils/file_utils.hpp"
 #include "framework/utils/string_utils.hpp"
+#include "framework/utils/yaml_utils.hpp"
+#include "models/steam/steam_game_config.hpp"
 #include "utils/constants.hpp"
 
+inline const int GAME_CONFIG_TIMEOUT_MS = 500;
+
 inline int run_command(std::shared_ptr<Logger> logger, const std::vector<std::string>& cmd, const std::vector<std::string>& wrappers,
 					   const std::string& parameters) {
 	std::vector<std::string> args;
@@ -32,6 +37,12 @@ inline int run_command(std::shared_ptr<Logger> logger, const std::vector<std::st
 		}
 	}
 
+	auto executable = FileUtils::findInPath(args[0]);
+	if (executable.empty()) {
+		logger->error("Command {} not found", args[0]);
+		return 127;
+	}
+
 	std::vector<char*> argv;
 	argv.reserve(args.size() + 1);
 	for (auto& arg : args) {
@@ -54,13 +65,51 @@ inline int run_command(std::shared_ptr<Logger> logger, const std::vector<std::st
 	dup2(fd, STDOUT_FILENO);
 	dup2(fd, STDERR_FILENO);
 	close(fd);
-	logger->error("PATH before execvp: {}", getenv("PATH"));
-	execvp(argv[0], argv.data());
+	logger->debug("PATH before execve: {}", getenv("PATH"));
+	LoggerProvider::flush();
+	execve(executable[0].c_str(), argv.data(), environ);
 
-	logger->error("Error on execvp: {}", std::strerror(errno));
+	logger->error("Error on execve: {}", std::strerror(errno));
 	return errno;
 }
 
+/**
+ * @brief Gets the launch configuration of a game from the running instance, or from the last one it gave.
+ *
+ * @param logger Runner logger.
+ * @param steamId Game id.
+ * @return The configuration, if any.
+ */
+inline std::optional<SteamGameConfig> loadGameConfig(std::shared_ptr<Logger> logger, const std::string& steamId) {
+	auto cacheFile = Constants::LAUNCH_CACHE_DIR + "/" + steamId + ".yaml";
+	bool cacheable = steamId.find('/') == std::string::npos;
+
+	std::string yaml;
+	try {
+		auto res = AbstractUnixSocketClient::invokeOnce(Constants::SOCKET_FILE, Constants::GAME_CFG, {steamId}, GAME_CONFIG_TIMEOUT_MS);
+		yaml	 = std::any_cast<std::string>(res[0]);
+	} catch (std::exception& e) {
+		logger->warn("Error requesting configuration: {}", e.what());
+	}
+
+	try {
+		if (!yaml.empty()) {
+			if (cacheable && (!FileUtils::exists(cacheFile) || FileUtils::readFileContent(cacheFile) != yaml)) {
+				FileUtils::mkdirs(Constants::LAUNCH_CACHE_DIR);
+				FileUtils::replaceFileContent(cacheFile, yaml);
+			}
+			return YamlUtils::parseYaml<SteamGameConfig>(yaml);
+		}
+		if (cacheable && FileUtils::exists(cacheFile)) {
+			logger->info("Using configuration cached on last launch");
+			return YamlUtils::readYamlFile<SteamGameConfig>(cacheFile);
+		}
+	} catch (std::exception& e) {
+		logger->error("Error loading configuration: {}", e.what());
+	}
+	return std::nullopt;
+}
+
 inline int runSteamWrapping(int argc, char* argv[]) {
 	LoggerProvider::initialize(Constants::LOG_RUNNER_FILE_NAME, Constants::LOG_DIR);
 
@@ -70,19 +119,21 @@ inline int runSteamWrapping(int argc, char* argv[]) {
 		logger->error("Error: no command provided");
 		return 1;
 	}
-	logger->error("Old PATH: {}", getenv("PATH"));
+	logger->debug("Old PATH: {}", getenv("PATH"));
 
 	std::string path = Constants::BIN_STEAM_DIR + ":" + getenv("PATH");
-	logger->error("New PATH: {}", path);
+	logger->debug("New PATH: {}", path);
 	setenv("PATH", path.c_str(), 1);
 
 	logger->info("===== Started wrapping =====");
-	logger->info(">>> Environment:");
-	Logger::add_tab();
-	for (char** env = environ; *env; ++env) {
-		logger->info(std::string(*env));
+	if (logger->isEnabled(LoggerLevel::DEBUG)) {
+		logger->debug(">>> Environment:");
+		Logger::add_tab();
+		for (char** env = environ; *env; ++env) {
+			logger->debug(std::string(*env));
+		}
+		Logger::rem_tab();
 	}
-	Logger::rem_tab();
 
 	std::ostringstream cmdline;
 	for (int i = 1; i < argc; i++) {
@@ -97,22 +148,12 @@ inline int runSteamWrapping(int argc, char* argv[]) {
 	std::string parameters;
 	std::vector<std::string> command;
 
-	for (char** env = environ; *env; ++env) {
-		std::string entry(*env);
-		size_t pos = entry.find('=');
-		if (pos != std::string::npos) {
-			setenv(entry.substr(0, pos).c_str(), entry.substr(pos + 1).c_str(), 1);
-		}
-	}
-
-	Shell& shell = Shell::getInstance();
-
-	auto cmdWhichResult = shell.whichAll(std::string(argv[1]));
+	auto cmdWhichResult = FileUtils::findInPath(std::string(argv[1]));
 	if (cmdWhichResult.empty()) {
 		logger->error("Command {} not found", std::string(argv[1]));
 		exit(127);
 	}
-	std::string finalCommandStr = StringUtils::trim(cmdWhichResult[0]);
+	std::string finalCommandStr = cmdWhichResult[0];
 
 	logger->info(std::string(argv[1]) + " -> " + finalCommandStr);
 
@@ -122,35 +163,33 @@ inline int runSteamWrapping(int argc, char* argv[]) {
 		command.push_back(argv[i]);
 	}
 
-	try {
-		const char* steamId = getenv("SteamGameId");
-		if (steamId) {
-			auto cfg = RogPerfTunerClient::getInstance().getGameConfig(steamId);
-			for (const auto& [key, val] : cfg.environment) {
+	const char* steamId = getenv("SteamGameId");
+	if (steamId) {
+		auto cfg = loadGameConfig(logger, steamId);
+		if (cfg.has_value()) {
+			for (const auto& [key, val] : cfg->environment) {
 				setenv(key.c_str(), val.c_str(), 1);
 			}
-			wrappers   = cfg.wrappers;
-			parameters = cfg.parameters;
+			wrappers   = cfg->wrappers;
+			parameters = cfg->parameters;
 
-			if (!cfg.environment.empty()) {
+			if (!cfg->environment.empty()) {
 				std::string envAdded;
-				for (const auto& [key, val] : cfg.environment) {
+				for (const auto& [key, val] : cfg->environment) {
 					envAdded = envAdded + key + ";";
 				}
 				envAdded.pop_back();
 				setenv("OVERRIDE_FLATPAK_ENV", envAdded.c_str(), 1);
 			}
-		} else {
-			logger->warn("No AppId provided");
 		}
-	} catch (std::exception& e) {
-		logger->error("Error requesting configuration {}", e.what());
+	} else {
+		logger->warn("No AppId provided");
 	}
 
 	std::optional<std::string> bin = std::string(argv[argc - 1]);
-	auto whichResult			   = shell.whichAll("flatpak");
+	auto whichResult			   = FileUtils::findInPath("flatpak");
 	if (whichResult.size() > 1) {
-		setenv("ORIG_FLATPAK_BIN", StringUtils::trim(whichResult[whichResult.size() - 1]).c_str(), 1);
+		setenv("ORIG_FLATPAK_BIN", whichResult[whichResult.size() - 1].c_str(), 1);
 
 		for (int i = argc - 1; i >= 1; i--) {
 			if (i == 1 || std::string(argv[i - 1]) == "--") {
@@ -159,16 +198,20 @@ inline int runSteamWrapping(int argc, char* argv[]) {
 			}
 		}
 
-		logger->error(*bin);
+		logger->debug(*bin);
 		if (FileUtils::exists(*bin)) {
 			try {
-				FileUtils::copy(*bin, *bin + ".bk");
-				auto content = FileUtils::readFileContent(*bin);
+				auto original = FileUtils::readFileContent(*bin);
+				auto content  = original;
 				for (auto wr : whichResult) {
 					content = StringUtils::replaceAll(content, wr, "flatpak");
 				}
-				FileUtils::writeFileContent(*bin, content);
-				logger->error(content);
+				// Already rewritten on a previous launch most of the times
+				if (content != original) {
+					FileUtils::copy(*bin, *bin + ".bk");
+					FileUtils::writeFileContent(*bin, content);
+					logger->debug(content);
+				}
 			} catch (std::exception& e) {
 				bin = std::nullopt;
 			}
@@ -178,4 +221,4 @@ inline int runSteamWrapping(int argc, char* argv[]) {
 	}
 
 	return run_command(logger, command, wrappers, parameters);
-}
+}
\ No newline at end of file
@@ -1,24 +1,55 @@
+#pragma once
+
+#include <any>
+#include <filesystem>
 #include <iostream>
 
 #include "clients/unix_socket/rog_perf_tuner_client.hpp"
+#include "framework/clients/abstract/abstract_unix_socket_client.hpp"
 #include "framework/logger/logger_provider.hpp"
+#include "utils/constants.hpp"
 
-inline void nextProfile() {
-	LoggerProvider::initialize();
-	std::cout << RogPerfTunerClient::getInstance().nextProfile() << std::endl;
+inline const int HOTKEY_TIMEOUT_MS = 3000;
+
+/**
+ * @brief Sends a hotkey request to the running instance and prints its result.
+ *
+ * Every key press starts a new process, so the request goes on a connection of its own, without initializing
+ * the logger nor starting the threads of RogPerfTunerClient.
+ *
+ * @param method Method name.
+ * @return Exit code.
+ */
+inline int sendHotkey(const std::string& method) {
+	try {
+		auto res = AbstractUnixSocketClient::invokeOnce(Constants::SOCKET_FILE, method, {}, HOTKEY_TIMEOUT_MS);
+		std::cout << std::any_cast<std::string>(res[0]) << std::endl;
+		return 0;
+	} catch (const std::exception& e) {
+		std::cerr << "Error while sending " << method << ": " << e.what() << std::endl;
+		return 1;
+	}
 }
 
-inline void nextEffect() {
-	LoggerProvider::initialize();
-	std::cout << RogPerfTunerClient::getInstance().nextEffect() << std::endl;
+inline int nextProfile() {
+	return sendHotkey(Constants::PERF_PROF);
 }
 
-inline void decreaseBrightness() {
-	LoggerProvider::initialize();
-	std::cout << RogPerfTunerClient::getInstance().decreaseBrightness() << std::endl;
+inline int nextEffect() {
+	return sendHotkey(Constants::NEXT_EFF);
 }
 
-inline void increaseBrightness() {
+inline int decreaseBrightness() {
+	return sendHotkey(Constants::DEC_BRIGHT);
+}
+
+inline void exportTrace(int argc, char** argv) {
 	LoggerProvider::initialize();
-	std::cout << RogPerfTunerClient::getInstance().increaseBrightness() << std::endl;
+	// The running instance has its own working directory
+	auto path = argc > 1 ? std::filesystem::absolute(argv[1]).string() : Constants::TRACE_FILE;
+	std::cout << RogPerfTunerClient::getInstance().exportTrace(path) << std::endl;
+}
+
+inline int increaseBrightness() {
+	return sendHotkey(Constants::INC_BRIGHT);
 }
\ No newline at end of file
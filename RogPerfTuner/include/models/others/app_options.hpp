@@ -15,7 +15,10 @@ enum class AppOptions : int {
 	dev_mode,
 	help,
 	flatpak,
-	run
+	run,
+	rgb_benchmark,
+	hotkey_benchmark,
+	trace
 };
 
 inline std::string getOption(AppOptions opt) {
@@ -107,11 +110,25 @@ inline std::optional<std::string> getDescription(AppOptions opt) {
 		return "           Show this help message";
 	}
 
+	if (opt == AppOptions::rgb_benchmark) {
+		return "  Benchmark lighting effects against a mock OpenRGB server [golden file]";
+	}
+
+	if (opt == AppOptions::hotkey_benchmark) {
+		return "   Measure hotkey latency against the running instance [iterations]";
+	}
+
+	if (opt == AppOptions::trace) {
+		return "          Export a Chrome/Perfetto trace of the running instance [file]";
+	}
+
 	return std::nullopt;
 }
 
 inline std::unordered_map<std::string, std::vector<AppOptions>> getOptionGroups() {
 	return {{"Performance Control", {AppOptions::performance}},
 			{"RGB lightning control", {AppOptions::effect, AppOptions::incBrightness, AppOptions::decBrightness}},
-			{"Application", {AppOptions::show, AppOptions::kill, AppOptions::dev_mode, AppOptions::version, AppOptions::help}}};
+			{"Application",
+			 {AppOptions::show, AppOptions::kill, AppOptions::dev_mode, AppOptions::rgb_benchmark, AppOptions::hotkey_benchmark, AppOptions::trace,
+			  AppOptions::version, AppOptions::help}}};
 }
\ No newline at end of file
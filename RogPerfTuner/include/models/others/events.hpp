@@ -18,6 +18,7 @@ enum class Events : int {
 	ORGB_SERVICE_ON_EFFECT,
 	ORGB_SERVICE_ON_COLOR,
 	PROFILE_SERVICE_ON_PROFILE,
+	PROFILE_SERVICE_ON_ACTUAL_PROFILE,
 	PROFILE_SERVICE_ON_SCHEDULER,
 	PROFILE_SERVICE_ON_SSD_SCHEDULER,
 	STEAM_SERVICE_GAME_EVENT,
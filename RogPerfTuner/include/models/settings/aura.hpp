@@ -7,11 +7,16 @@
 #include "framework/utils/enum_utils.hpp"
 #include "models/hardware/rgb_brightness.hpp"
 #include "models/settings/effect.hpp"
+#include "models/settings/rgb_correction.hpp"
 
 struct Aura {
-	RgbBrightness brightness				   = RgbBrightness::MAX;
-	std::map<std::string, EffectConfig> config = {};
-	std::optional<std::string> last_effect	   = std::nullopt;
+	inline static const uint32_t DEFAULT_FPS = 30;
+
+	RgbBrightness brightness						 = RgbBrightness::MAX;
+	std::map<std::string, EffectConfig> config		 = {};
+	std::optional<std::string> last_effect			 = std::nullopt;
+	uint32_t fps									 = DEFAULT_FPS;
+	std::map<std::string, RgbCorrection> corrections = {};
 };
 
 // YAML-CPP serialization/deserialization
@@ -27,6 +32,12 @@ struct convert<Aura> {
 		if (aura.last_effect) {
 			node["effect"] = *aura.last_effect;
 		}
+		if (aura.fps != Aura::DEFAULT_FPS) {
+			node["fps"] = aura.fps;
+		}
+		if (!aura.corrections.empty()) {
+			node["corrections"] = aura.corrections;
+		}
 		return node;
 	}
 
@@ -43,6 +54,14 @@ struct convert<Aura> {
 			aura.last_effect = node["effect"].as<std::string>();
 		}
 
+		if (node["fps"]) {
+			aura.fps = node["fps"].as<uint32_t>();
+		}
+
+		if (node["corrections"]) {
+			aura.corrections = node["corrections"].as<std::map<std::string, RgbCorrection>>();
+		}
+
 		return true;
 	}
 };
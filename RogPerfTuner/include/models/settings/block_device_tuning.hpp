@@ -0,0 +1,96 @@
+#pragma once
+
+#include <yaml-cpp/yaml.h>
+
+#include <map>
+#include <optional>
+#include <string>
+
+struct BlockDeviceTuning {
+	inline static const std::string ALL_DEVICES	  = "*";
+	inline static const std::string STEAM_DEVICES = "steam";
+
+	std::optional<std::string> scheduler = std::nullopt;
+	std::optional<int> readAheadKb		 = std::nullopt;
+	std::optional<int> nrRequests		 = std::nullopt;
+	std::optional<int> wbtLatUsec		 = std::nullopt;
+	std::optional<int> rqAffinity		 = std::nullopt;
+
+	/**
+	 * @brief Overlays the values set in other over this tuning.
+	 *
+	 * @param other Tuning whose present values take precedence.
+	 */
+	void merge(const BlockDeviceTuning& other) {
+		if (other.scheduler.has_value()) {
+			scheduler = other.scheduler;
+		}
+		if (other.readAheadKb.has_value()) {
+			readAheadKb = other.readAheadKb;
+		}
+		if (other.nrRequests.has_value()) {
+			nrRequests = other.nrRequests;
+		}
+		if (other.wbtLatUsec.has_value()) {
+			wbtLatUsec = other.wbtLatUsec;
+		}
+		if (other.rqAffinity.has_value()) {
+			rqAffinity = other.rqAffinity;
+		}
+	}
+
+	bool operator==(const BlockDeviceTuning&) const = default;
+};
+
+/**
+ * @brief IO preset, keyed by device name, "*" for every device or "steam" for the devices holding Steam libraries.
+ */
+using IoPreset = std::map<std::string, BlockDeviceTuning>;
+
+// YAML-CPP serialization/deserialization
+namespace YAML {
+template <>
+struct convert<BlockDeviceTuning> {
+	static Node encode(const BlockDeviceTuning& tuning) {
+		Node node(NodeType::Map);
+		if (tuning.scheduler.has_value()) {
+			node["scheduler"] = *tuning.scheduler;
+		}
+		if (tuning.readAheadKb.has_value()) {
+			node["readAheadKb"] = *tuning.readAheadKb;
+		}
+		if (tuning.nrRequests.has_value()) {
+			node["nrRequests"] = *tuning.nrRequests;
+		}
+		if (tuning.wbtLatUsec.has_value()) {
+			node["wbtLatUsec"] = *tuning.wbtLatUsec;
+		}
+		if (tuning.rqAffinity.has_value()) {
+			node["rqAffinity"] = *tuning.rqAffinity;
+		}
+		return node;
+	}
+
+	static bool decode(const Node& node, BlockDeviceTuning& tuning) {
+		if (!node.IsMap()) {
+			return false;
+		}
+		if (node["scheduler"] && !node["scheduler"].IsNull()) {
+			tuning.scheduler = node["scheduler"].as<std::string>();
+		}
+		if (node["readAheadKb"] && !node["readAheadKb"].IsNull()) {
+			tuning.readAheadKb = node["readAheadKb"].as<int>();
+		}
+		if (node["nrRequests"] && !node["nrRequests"].IsNull()) {
+			tuning.nrRequests = node["nrRequests"].as<int>();
+		}
+		if (node["wbtLatUsec"] && !node["wbtLatUsec"].IsNull()) {
+			tuning.wbtLatUsec = node["wbtLatUsec"].as<int>();
+		}
+		if (node["rqAffinity"] && !node["rqAffinity"].IsNull()) {
+			tuning.rqAffinity = node["rqAffinity"].as<int>();
+		}
+		return true;
+	}
+};
+}  // namespace YAML
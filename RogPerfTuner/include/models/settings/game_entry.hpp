@@ -19,6 +19,7 @@ struct GameEntry {
 	std::optional<std::string> env		 = std::nullopt;
 	std::optional<std::string> gpu		 = std::nullopt;
 	std::optional<std::string> scheduler = std::nullopt;
+	std::optional<std::string> ioPreset	 = std::nullopt;
 	MangoHudLevel metrics_level			 = DEFAULT_METRICS_LEVEL;
 	std::string name;
 	std::optional<std::string> overlayId;
@@ -66,6 +67,9 @@ struct convert<GameEntry> {
 		if (game.scheduler && !game.scheduler->empty()) {
 			node["scheduler"] = *game.scheduler;
 		}
+		if (game.ioPreset && !game.ioPreset->empty()) {
+			node["ioPreset"] = *game.ioPreset;
+		}
 		if (game.wrappers && !game.wrappers->empty()) {
 			node["wrappers"] = *game.wrappers;
 		}
@@ -98,6 +102,10 @@ struct convert<GameEntry> {
 			game.scheduler = node["scheduler"].as<std::string>();
 		}
 
+		if (node["ioPreset"] && !node["ioPreset"].IsNull()) {
+			game.ioPreset = node["ioPreset"].as<std::string>();
+		}
+
 		if (node["proton"]) {
 			game.proton = node["proton"].as<bool>();
 		}
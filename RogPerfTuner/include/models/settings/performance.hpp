@@ -6,11 +6,13 @@
 
 #include "framework/utils/enum_utils.hpp"
 #include "models/performance/performance_profile.hpp"
+#include "models/settings/block_device_tuning.hpp"
 
 struct Performance {
-	PerformanceProfile profile			 = PerformanceProfile::SMART;
-	std::optional<std::string> scheduler = std::nullopt;
-	std::string ssdScheduler			 = "none";
+	PerformanceProfile profile				  = PerformanceProfile::SMART;
+	std::optional<std::string> scheduler	  = std::nullopt;
+	std::string ssdScheduler				  = "none";
+	std::map<std::string, IoPreset> ioPresets = {};
 };
 
 // YAML-CPP serialization/deserialization
@@ -26,6 +28,9 @@ struct convert<Performance> {
 		if (perf.ssdScheduler != "none") {
 			node["ssdScheduler"] = perf.ssdScheduler;
 		}
+		if (!perf.ioPresets.empty()) {
+			node["ioPresets"] = perf.ioPresets;
+		}
 		return node;
 	}
 
@@ -47,6 +52,9 @@ struct convert<Performance> {
 		} else {
 			perf.ssdScheduler = "none";
 		}
+		if (node["ioPresets"]) {
+			perf.ioPresets = node["ioPresets"].as<std::map<std::string, IoPreset>>();
+		}
 		return true;
 	}
 };
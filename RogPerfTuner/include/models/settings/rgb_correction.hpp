@@ -0,0 +1,33 @@
+#pragma once
+
+#include <yaml-cpp/yaml.h>
+
+#include <string>
+
+struct RgbCorrection {
+	double gamma	  = 1.0;
+	std::string white = "FFFFFF";
+};
+
+// YAML-CPP serialization/deserialization
+namespace YAML {
+template <>
+struct convert<RgbCorrection> {
+	static Node encode(const RgbCorrection& correction) {
+		Node node;
+		node["gamma"] = correction.gamma;
+		node["white"] = correction.white;
+		return node;
+	}
+
+	static bool decode(const Node& node, RgbCorrection& correction) {
+		if (node["gamma"]) {
+			correction.gamma = node["gamma"].as<double>();
+		}
+		if (node["white"]) {
+			correction.white = node["white"].as<std::string>();
+		}
+		return true;
+	}
+};
+}  // namespace YAML
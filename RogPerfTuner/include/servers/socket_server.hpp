@@ -1,6 +1,20 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <variant>
+
 #include "framework/clients/abstract/abstract_unix_socket_client.hpp"
+#include "framework/events/event_executor.hpp"
+#include "framework/models/cpu_usage.hpp"
 #include "gui/main_window.hpp"
 #include "services/hardware_service.hpp"
 #include "services/open_rgb_service.hpp"
@@ -8,32 +22,171 @@
 #include "services/steam_service.hpp"
 #include "utils/event_bus_wrapper.hpp"
 
+/**
+ * @brief Serves the requests of RogPerfTunerClient on the unix socket.
+ *
+ * A single thread multiplexes the listening socket and every client with epoll, clients are non blocking and
+ * responses are written with writev. Requests are run on their own lane of the EventExecutor so a slow one doesn't
+ * hold back the other clients, and each response uses the encoding of its request, UnixMessageCodec or YAML. A
+ * client that shuts down its sending side still gets the responses of the requests it already sent.
+ *
+ * A connection can also subscribe to topics, passing their names to subscribe and optionally a number with the
+ * telemetry interval in milliseconds. It gets the whole state of each topic first and then an EVENT with the
+ * fields that changed, as name and value pairs, telemetry being the CPU usage sampled at that interval. Events
+ * wait while a subscriber has too many frames queued, and it gets a single event with the latest values of
+ * each topic once it catches up.
+ */
 class SocketServer : public Singleton<SocketServer>, Loggable {
+  public:
+	inline static const int MAX_EVENTS			   = 32;
+	inline static const int MAX_IOVECS			   = 64;
+	inline static const uint32_t MAX_MESSAGE_BYTES = 10 * 1024 * 1024;
+	inline static const auto START_TIMEOUT		   = std::chrono::seconds(5);
+	inline static const size_t MAX_QUEUED_EVENTS   = 16;
+	inline static const int MIN_TELEMETRY_MS	   = 100;
+	inline static const int DEFAULT_TELEMETRY_MS   = 1000;
+
+	inline static const std::string TOPIC_PROFILE	= "profile";
+	inline static const std::string TOPIC_SCHEDULER	= "scheduler";
+	inline static const std::string TOPIC_RGB		= "rgb";
+	inline static const std::string TOPIC_GAMES		= "games";
+	inline static const std::string TOPIC_BATTERY	= "battery";
+	inline static const std::string TOPIC_TELEMETRY	= "telemetry";
+	inline static const std::set<std::string> TOPICS{TOPIC_PROFILE, TOPIC_SCHEDULER, TOPIC_RGB, TOPIC_GAMES, TOPIC_BATTERY, TOPIC_TELEMETRY};
+
+	~SocketServer();
+
+	/**
+	 * @brief Closes every connection and removes the socket file, then logs the metrics.
+	 */
+	void stop();
+
   private:
-	int server_fd{-1};
+	using Clock = std::chrono::steady_clock;
+
+	inline static const uint64_t LISTEN_ID = 0;
+	inline static const uint64_t WAKE_ID   = 1;
+
+	enum class State { STARTING, LISTENING, FAILED };
+
+	using Field	 = std::variant<bool, int, std::string>;
+	using Fields = std::map<std::string, Field>;
+
+	struct Stats {
+		uint64_t accepted	  = 0;
+		size_t connections	  = 0;
+		size_t maxConnections = 0;
+		uint64_t requests	  = 0;
+		uint64_t failed		  = 0;
+		uint64_t events		  = 0;
+		uint64_t heldBack	  = 0;
+		double latencyMs	  = 0;
+		double maxLatencyMs	  = 0;
+	};
+
+	struct Frame {
+		uint32_t length;
+		std::string payload;
+		size_t sent = 0;
+	};
+
+	struct Subscription {
+		bool binary;
+		std::set<std::string> topics;
+		std::unordered_map<std::string, Fields> sent;
+		std::set<std::string> heldBack;
+		int telemetryMs = DEFAULT_TELEMETRY_MS;
+		Clock::time_point nextTelemetry;
+		CPUUsage cpu;
+	};
+
+	struct Connection {
+		int fd;
+		std::string input;
+		std::deque<Frame> output;
+		bool pollingOutput = false;
+		bool readClosed	   = false;
+		size_t pending	   = 0;
+		std::optional<Subscription> subscription;
+	};
+
+	struct Completion {
+		uint64_t connection;
+		Clock::time_point received;
+		bool failed;
+		std::string payload;
+	};
+
+	struct Update {
+		std::string topic;
+		Fields fields;
+	};
+
+	int serverFd = -1;
+	int epollFd	 = -1;
+	int wakeFd	 = -1;
 
 	std::thread runner;
 	std::atomic<bool> started{false};
 
+	std::mutex stateMutex;
+	std::condition_variable stateCv;
+	State state = State::STARTING;
+
+	uint64_t nextConnection = WAKE_ID + 1;
+	std::unordered_map<uint64_t, Connection> connections;
+
+	std::mutex completionMutex;
+	std::vector<Completion> completions;
+	std::vector<Update> updates;
+
+	std::unordered_map<std::string, Fields> topicState;
+
+	std::unordered_map<std::string, EventExecutor::TopicId> requestTopics;
+	EventExecutor::TopicId otherRequests = 0;
+
+	Stats stats;
+
 	EventBusWrapper& eventBus			   = EventBusWrapper::getInstance();
+	EventExecutor& executor				   = EventExecutor::getInstance();
 	PerformanceService& performanceService = PerformanceService::getInstance();
 	OpenRgbService& openRgbService		   = OpenRgbService::getInstance();
 	HardwareService& hardwareService	   = HardwareService::getInstance();
 	SteamService& steamService			   = SteamService::getInstance();
 	MainWindow& mainWindow				   = MainWindow::getInstance();
 
+	bool listenSocket();
+	void setState(State value);
 	void run();
 
-	void handleClient(int client_fd);
+	void acceptClients();
+	bool readClient(Connection& connection, uint64_t id);
+	bool writeClient(Connection& connection, uint64_t id);
+	void closeClient(uint64_t id);
+	void flushClient(Connection& connection, uint64_t id);
+	bool watchClient(Connection& connection, uint64_t id);
+	static bool finished(const Connection& connection);
 
-	void handleRequest(int clientFd, const UnixCommunicationMessage& req);
+	void dispatch(uint64_t id, std::string&& payload);
+	void complete(Completion&& completion);
+	void wake();
+	void drainCompletions();
+	void respond(Completion&& completion);
+
+	void watchState();
+	void publish(const std::string& topic, Fields&& fields);
+	void drainUpdates();
+	void subscribe(Connection& connection, const UnixCommunicationMessage& req, UnixCommunicationMessage& res, bool binary);
+	void unsubscribe(Connection& connection, const UnixCommunicationMessage& req, UnixCommunicationMessage& res);
+	void notify(Connection& connection, uint64_t id, const std::string& topic);
+	bool queueEvent(Connection& connection, const std::string& topic, const Fields& fields);
+	bool queueHeldBack(Connection& connection);
+	int telemetryTimeout();
+	void publishTelemetry();
+
+	UnixCommunicationMessage handleRequest(const UnixCommunicationMessage& req);
 	void handleEvent(const UnixCommunicationMessage& req);
 
 	SocketServer();
 	friend class Singleton<SocketServer>;
-
-  public:
-	~SocketServer();
-
-	void stop();
 };
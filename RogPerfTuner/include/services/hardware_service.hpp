@@ -87,7 +87,7 @@ class HardwareService : public Singleton<HardwareService>, Loggable {
 
 	void setupDeviceLoop();
 	void onBatteryEvent(bool onBattery, bool muted = false);
-	void onDeviceEvent();
+	void onDeviceEvent(const std::vector<UsbIdentifier>& addedDevices, const std::vector<UsbIdentifier>& removedDevices);
 
 	std::mutex actionMutex;
 
@@ -112,7 +112,6 @@ class HardwareService : public Singleton<HardwareService>, Loggable {
 	ConfigurationWrapper& configuration = ConfigurationWrapper::getInstance();
 
 	std::unordered_map<std::string, std::string> gpus;
-	std::vector<UsbIdentifier> connectedDevices;
 
 	bool onBattery				  = true;
 	unsigned int runningGames	  = 0;
@@ -34,6 +34,7 @@
 #ifdef SCALING_GOVERNOR
 #include "clients/file/scaling_governor_client.hpp"
 #endif
+#include "clients/file/block_device_client.hpp"
 #include "clients/file/sched_bore_client.hpp"
 #include "clients/file/ssd_scheduler_client.hpp"
 #include "clients/shell/asusctl_client.hpp"
@@ -114,6 +115,20 @@ class PerformanceService : public Singleton<PerformanceService>, Loggable {
 	 */
 	void setSsdScheduler(const std::string& scheduler, bool temporal = false);
 
+	/**
+	 * @brief Gets the names of the configured IO presets.
+	 *
+	 * @return A vector of preset names.
+	 */
+	std::vector<std::string> getIoPresets();
+
+	/**
+	 * @brief Sets the IO preset requested by the running games, applied over the profile one on the next profile switch.
+	 *
+	 * @param preset The preset name, or std::nullopt to go back to the profile preset.
+	 */
+	void setGameIoPreset(const std::optional<std::string>& preset);
+
 #ifdef FAN_CONTROL
 	/**
 	 * @brief Gets the list of available fans.
@@ -168,6 +183,8 @@ class PerformanceService : public Singleton<PerformanceService>, Loggable {
 	inline static const uint8_t IO_PRIORITY	 = (CPU_PRIORITY + 20) / 5;
 	inline static const uint8_t IO_CLASS	 = 2;
 
+	inline static const std::string GAME_LOADING_IO_PRESET = "gameLoading";
+
 	friend class Singleton<PerformanceService>;
 	PerformanceService();
 
@@ -176,10 +193,12 @@ class PerformanceService : public Singleton<PerformanceService>, Loggable {
 
 	std::mutex perProfMutex;
 	std::mutex actProfMutex;
+	std::mutex ioPresetMutex;
 
 	PerformanceProfile actualProfile			   = PerformanceProfile::PERFORMANCE;
 	PerformanceProfile currentProfile			   = PerformanceProfile::SMART;
 	std::optional<std::string> currentSsdScheduler = "none";
+	std::optional<std::string> gameIoPreset		   = std::nullopt;
 	std::optional<std::thread> smartThread		   = std::nullopt;
 	std::atomic<bool> stopFlag					   = false;
 	std::string defaultScheduler;
@@ -221,11 +240,17 @@ class PerformanceService : public Singleton<PerformanceService>, Loggable {
 	ConfigurationWrapper& configuration	   = ConfigurationWrapper::getInstance();
 	Translator& translator				   = Translator::getInstance();
 	SsdSchedulerClient& ssdSchedulerClient = SsdSchedulerClient::getInstance();
+	BlockDeviceClient& blockDeviceClient   = BlockDeviceClient::getInstance();
 	ScxCtlClient& scxCtlClient			   = ScxCtlClient::getInstance();
 	AsusCtlClient& asusCtlClient		   = AsusCtlClient::getInstance();
 	Shell& shell						   = Shell::getInstance();
 
 	void setPlatformProfile(PerformanceProfile profile);
+	void setIoPreset(PerformanceProfile profile);
+
+#ifdef FAN_CONTROL
+	FanCurve getConfiguredCurve(const std::string& fan, const std::string& profile);
+#endif
 
 #ifdef BOOST_CONTROL
 	void setBoost(PerformanceProfile profile);
@@ -58,9 +58,9 @@ class SteamService : public Singleton<SteamService>, Loggable {
 	/**
 	 * @brief Gets the map of all known games.
 	 *
-	 * @return A constant reference to a map of games, keyed by their string IDs.
+	 * @return A copy of the map of games, keyed by their IDs.
 	 */
-	const std::map<uint, GameEntry>& getGames();
+	std::map<uint, GameEntry> getGames();
 
 	/**
 	 * @brief Checks if a game with the given app ID is currently running.
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "framework/abstracts/loggable.hpp"
 #include "framework/abstracts/singleton.hpp"
 #include "framework/configuration/configuration.hpp"
@@ -9,16 +12,17 @@
 class ConfigurationWrapper : public Singleton<ConfigurationWrapper>, Loggable {
   public:
 	/**
-	 * @brief Saves the current configuration to persistent storage.
-	 *
-	 * This method serializes and writes the current configuration settings
-	 * to a file or other persistent medium, ensuring that changes are retained
-	 * across application restarts.
+	 * @brief Marks the current configuration to be saved to persistent storage.
 	 *
-	 * @note Throws an exception if saving fails.
+	 * The write happens shortly after in the background, coalescing later changes.
 	 */
 	void saveConfig();
 
+	/**
+	 * @brief Writes the pending configuration changes before returning.
+	 */
+	void flushConfig();
+
 	/**
 	 * @brief Loads the configuration settings from the appropriate source.
 	 *
@@ -35,9 +39,16 @@ class ConfigurationWrapper : public Singleton<ConfigurationWrapper>, Loggable {
 	/**
 	 * @brief Retrieves the current root configuration.
 	 *
-	 * @return Reference to the RootConfig object containing the application's configuration settings.
+	 * @return Immutable snapshot of the application's configuration settings, it never changes while held.
+	 */
+	std::shared_ptr<const RootConfig> getConfiguration();
+
+	/**
+	 * @brief Modifies the configuration and schedules it to be saved.
+	 *
+	 * @param mutator Function applied to a copy of the current configuration, published once it returns.
 	 */
-	RootConfig& getConfiguration();
+	void updateConfiguration(const std::function<void(RootConfig&)>& mutator);
 
 	/**
 	 * @brief Retrieves the stored password.
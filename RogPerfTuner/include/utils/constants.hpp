@@ -38,10 +38,12 @@ class Constants {
 	static const std::string NEXT_EFFECT_PATH;
 	static const std::string CONFIG_DIR;
 	static const std::string CONFIG_FILE;
+	static const std::string ORGB_DEVICES_FILE;
 	static const std::string LOGOS_DIR;
 	static const std::string LIB_DIR;
 	static const std::string LOG_DIR;
 	static const std::string LOG_OLD_DIR;
+	static const std::string TRACE_FILE;
 
 	static const std::string LOG_FILE_NAME;
 	static const std::string LOG_RUNNER_FILE_NAME;
@@ -57,6 +59,9 @@ class Constants {
 	static const std::string INC_BRIGHT;
 	static const std::string NEXT_EFF;
 	static const std::string SHOW_GUI;
+	static const std::string EXPORT_TRACE;
+	static const std::string SUBSCRIBE;
+	static const std::string UNSUBSCRIBE;
 
 	static const std::string SOCKET_FILE;
 
@@ -69,6 +74,7 @@ class Constants {
 	static const std::string BIN_STEAM_DIR;
 	static const std::string FLATPAK_WRAPPER_PATH;
 	static const std::string STEAM_WRAPPER_PATH;
+	static const std::string LAUNCH_CACHE_DIR;
 	static const std::string LIB_VK_DIR;
 	static const std::string LIB_OCL_DIR;
 	static const std::string USER_PLUGIN_DIR;
@@ -78,6 +84,7 @@ class Constants {
 	static const std::string RCCDC_PATH;
 	static const std::string RCCDC_PACKAGE_FILE;
 	static const std::string STEAM_USERDATA_PATH;
+	static const std::string STEAM_LIBRARIES_FILE;
 	static const std::string DECKY_SERVICE_PATH;
 	static const std::string URL_GAME_CFG;
 	static const std::string GAME_CFG;
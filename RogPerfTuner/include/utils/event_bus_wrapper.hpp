@@ -1,19 +1,139 @@
 #pragma once
 
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "framework/abstracts/singleton.hpp"
 #include "framework/events/event_bus.hpp"
+#include "framework/events/event_channel.hpp"
+#include "framework/events/event_executor.hpp"
+#include "framework/tracing/tracer.hpp"
+#include "framework/utils/enum_utils.hpp"
 #include "models/hardware/battery_charge_threshold.hpp"
 #include "models/hardware/rgb_brightness.hpp"
 #include "models/hardware/usb_identifier.hpp"
+#include "models/others/events.hpp"
 #include "models/performance/performance_profile.hpp"
-class EventBusWrapper : public Singleton<EventBusWrapper> {
+
+/**
+ * @brief Channel type of each event, events without payload use EventChannel<>.
+ */
+template <Events E>
+struct EventTraits {
+	using Channel = EventChannel<>;
+};
+
+template <>
+struct EventTraits<Events::UDEV_CLIENT_DEVICE_EVENT> {
+	using Channel = EventChannel<std::vector<UsbIdentifier>, std::vector<UsbIdentifier>>;
+};
+
+template <>
+struct EventTraits<Events::HARDWARE_SERVICE_USB_REMOVED> {
+	using Channel = EventChannel<std::vector<UsbIdentifier>>;
+};
+
+template <>
+struct EventTraits<Events::HARDWARE_SERVICE_ON_BATTERY> {
+	using Channel = EventChannel<bool>;
+};
+
+template <>
+struct EventTraits<Events::BATTERY_STATUS> {
+	using Channel = EventChannel<bool>;
+};
+
+#ifdef BAT_LIMIT
+template <>
+struct EventTraits<Events::HARDWARE_SERVICE_THRESHOLD_CHANGED> {
+	using Channel = EventChannel<BatteryThreshold>;
+};
+#endif
+
+#ifdef BOOT_SOUND
+template <>
+struct EventTraits<Events::HARDWARE_SERVICE_BOOT_SOUND_CHANGED> {
+	using Channel = EventChannel<bool>;
+};
+#endif
+
+template <>
+struct EventTraits<Events::ORGB_SERVICE_ON_BRIGHTNESS> {
+	using Channel = EventChannel<RgbBrightness>;
+};
+
+template <>
+struct EventTraits<Events::ORGB_SERVICE_ON_EFFECT> {
+	using Channel = EventChannel<std::string>;
+};
+
+template <>
+struct EventTraits<Events::ORGB_SERVICE_ON_COLOR> {
+	using Channel = EventChannel<std::optional<std::string>>;
+};
+
+template <>
+struct EventTraits<Events::PROFILE_SERVICE_ON_PROFILE> {
+	using Channel = EventChannel<PerformanceProfile>;
+};
+
+template <>
+struct EventTraits<Events::PROFILE_SERVICE_ON_ACTUAL_PROFILE> {
+	using Channel = EventChannel<PerformanceProfile>;
+};
+
+template <>
+struct EventTraits<Events::PROFILE_SERVICE_ON_SCHEDULER> {
+	using Channel = EventChannel<std::optional<std::string>>;
+};
+
+template <>
+struct EventTraits<Events::PROFILE_SERVICE_ON_SSD_SCHEDULER> {
+	using Channel = EventChannel<std::string>;
+};
+
+template <>
+struct EventTraits<Events::STEAM_SERVICE_GAME_EVENT> {
+	using Channel = EventChannel<size_t>;
+};
+
+/**
+ * @brief Typed access to the application events.
+ *
+ * Hardware events (udev, USB, battery and games) are handed to the EventExecutor so polling and monitor
+ * threads never run the handlers themselves; every other event is delivered on the emitting thread.
+ */
+class EventBusWrapper : public Singleton<EventBusWrapper>, Loggable {
   private:
 	friend class Singleton<EventBusWrapper>;
 	EventBusWrapper();
 
-	EventBus& eventBus = EventBus::getInstance();
+	EventBus& eventBus		= EventBus::getInstance();
+	EventExecutor& executor = EventExecutor::getInstance();
+
+	template <Events E>
+	inline static typename EventTraits<E>::Channel channel;
+
+	template <Events E, typename... Args>
+	void emit(const Args&... args) {
+		TraceSpan span("events", magic_enum::enum_name(E));
+		try {
+			channel<E>.emit(args...);
+		} catch (const std::exception& e) {
+			logger->error("Error while handling {}: {}", toName(E), e.what());
+		}
+	}
+
+	template <Events E, typename... Args>
+	void post(EventPriority priority, bool coalesce, const Args&... args) {
+		// Registered once per event, so posting doesn't build its name again
+		static const EventExecutor::TopicId topic = executor.registerTopic(toName(E));
+		TraceSpan span("events", magic_enum::enum_name(E));
+		executor.submit(topic, priority, coalesce, [args...] {
+			channel<E>.emit(args...);
+		});
+	}
 
   public:
 	void onApplicationStop(Callback&& callback);
@@ -41,14 +161,16 @@ class EventBusWrapper : public Singleton<EventBusWrapper> {
 
 	/**
 	 * @brief Registers a callback for device events.
-	 * @param callback The callback function to be called when a device event occurs.
+	 * @param callback The callback function to be called with the USB devices added and removed.
 	 */
-	void onDeviceEvent(Callback&& callback);
+	void onDeviceEvent(std::function<void(const std::vector<UsbIdentifier>&, const std::vector<UsbIdentifier>&)>&& callback);
 
 	/**
 	 * @brief Emits a device event.
+	 * @param added The USB devices plugged in.
+	 * @param removed The USB devices unplugged.
 	 */
-	void emitDeviceEvent();
+	void emitDeviceEvent(const std::vector<UsbIdentifier>& added, const std::vector<UsbIdentifier>& removed);
 
 	/**
 	 * @brief Registers a callback for application stop events.
@@ -112,7 +234,7 @@ class EventBusWrapper : public Singleton<EventBusWrapper> {
 	 * @brief Registers a callback for RGB effect events.
 	 * @param callback The callback function to be called with the new RGB effect.
 	 */
-	void onRgbEffect(std::function<void(std::string)>&& callback);
+	void onRgbEffect(std::function<void(const std::string&)>&& callback);
 
 	/**
 	 * @brief Emits an RGB effect event.
@@ -132,6 +254,18 @@ class EventBusWrapper : public Singleton<EventBusWrapper> {
 	 */
 	void emitPerformanceProfile(const PerformanceProfile& profile);
 
+	/**
+	 * @brief Registers a callback for applied performance profile events.
+	 * @param callback The callback function to be called with the profile applied, resolved when SMART is selected.
+	 */
+	void onActualPerformanceProfile(std::function<void(PerformanceProfile)>&& callback);
+
+	/**
+	 * @brief Emits an applied performance profile event.
+	 * @param profile The profile applied to the hardware.
+	 */
+	void emitActualPerformanceProfile(const PerformanceProfile& profile);
+
 	/**
 	 * @brief Registers a callback for game events.
 	 * @param callback The callback function to be called with the number of running games.
@@ -159,13 +293,13 @@ class EventBusWrapper : public Singleton<EventBusWrapper> {
 	 * @brief Registers a callback for USB removed events.
 	 * @param callback The callback function to be called with the list of removed USB identifiers.
 	 */
-	void onUsbRemoved(std::function<void(std::vector<UsbIdentifier>)>&& callback);
+	void onUsbRemoved(std::function<void(const std::vector<UsbIdentifier>&)>&& callback);
 
 	/**
 	 * @brief Emits a USB removed event.
 	 * @param identifiers The list of removed USB identifiers.
 	 */
-	void emitUsbRemoved(const std::vector<UsbIdentifier>&);
+	void emitUsbRemoved(const std::vector<UsbIdentifier>& identifiers);
 
 	/**
 	 * @brief Registers a callback for battery status events.
@@ -183,13 +317,13 @@ class EventBusWrapper : public Singleton<EventBusWrapper> {
 	 * @brief Registers a callback for RGB color events.
 	 * @param callback The callback function to be called with the new RGB color (optional).
 	 */
-	void onRgbColor(std::function<void(std::optional<std::string>)>&& callback);
+	void onRgbColor(std::function<void(const std::optional<std::string>&)>&& callback);
 
 	/**
 	 * @brief Emits an RGB color event.
 	 * @param color The new RGB color value (optional).
 	 */
-	void emitRgbColor(std::optional<std::string> color);
+	void emitRgbColor(const std::optional<std::string>& color);
 
 	/**
 	 * @brief Registers a callback to be executed by the scheduler.
@@ -202,7 +336,7 @@ class EventBusWrapper : public Singleton<EventBusWrapper> {
 	 *        std::optional<std::string> argument and returns void. The callback will be invoked
 	 *        by the scheduler when appropriate.
 	 */
-	void onScheduler(std::function<void(std::optional<std::string>)>&& callback);
+	void onScheduler(std::function<void(const std::optional<std::string>&)>&& callback);
 
 	/**
 	 * @brief Emits an event related to the scheduler.
@@ -213,11 +347,11 @@ class EventBusWrapper : public Singleton<EventBusWrapper> {
 	 *
 	 * @param scheduler An optional string containing the scheduler's name or identifier.
 	 */
-	void emitScheduler(std::optional<std::string> scheduler);
+	void emitScheduler(const std::optional<std::string>& scheduler);
 
-	void onSsdScheduler(std::function<void(std::string)>&& callback);
+	void onSsdScheduler(std::function<void(const std::string&)>&& callback);
 
-	void emitSsdScheduler(std::string scheduler);
+	void emitSsdScheduler(const std::string& scheduler);
 
 	void onBatteryStatus(std::function<void(bool)>&& callback);
 
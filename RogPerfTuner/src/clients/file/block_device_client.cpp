@@ -0,0 +1,226 @@
+#include "clients/file/block_device_client.hpp"
+
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <regex>
+
+#include "framework/utils/file_utils.hpp"
+#include "framework/utils/string_utils.hpp"
+#include "utils/constants.hpp"
+
+namespace {
+const std::string SYS_BLOCK_DIR						 = "/sys/block";
+const std::vector<std::string> IGNORED_DEVICE_PREFIX = {"loop", "ram", "zram", "sr", "fd", "dm-", "md"};
+
+std::optional<int> readInt(const std::string& path) {
+	if (!FileUtils::exists(path)) {
+		return std::nullopt;
+	}
+	try {
+		return std::stoi(StringUtils::trim(FileUtils::readFileContent(path)));
+	} catch (std::exception& e) {
+		return std::nullopt;
+	}
+}
+}  // namespace
+
+BlockDeviceClient::BlockDeviceClient() : Loggable("BlockDeviceClient") {
+	if (FileUtils::exists(SYS_BLOCK_DIR)) {
+		for (const auto& entry : std::filesystem::directory_iterator(SYS_BLOCK_DIR)) {
+			auto name = entry.path().filename().string();
+			if (std::any_of(IGNORED_DEVICE_PREFIX.begin(), IGNORED_DEVICE_PREFIX.end(), [&name](const std::string& prefix) {
+					return name.starts_with(prefix);
+				})) {
+				continue;
+			}
+			if (!FileUtils::exists(SYS_BLOCK_DIR + "/" + name + "/queue/scheduler")) {
+				continue;
+			}
+
+			devices.emplace_back(name);
+			defaults[name] = readTuning(name);
+			current[name]  = defaults[name];
+		}
+	}
+	std::sort(devices.begin(), devices.end());
+
+	steamDevices = resolveSteamDevices();
+}
+
+bool BlockDeviceClient::available() {
+	return !devices.empty();
+}
+
+std::vector<std::string> BlockDeviceClient::getDevices() {
+	return devices;
+}
+
+std::set<std::string> BlockDeviceClient::getSteamDevices() {
+	return steamDevices;
+}
+
+std::vector<std::string> BlockDeviceClient::getAvailableSchedulers(const std::string& device) {
+	auto it = schedulers.find(device);
+	if (it == schedulers.end()) {
+		return {};
+	}
+	return it->second;
+}
+
+BlockDeviceTuning BlockDeviceClient::readTuning(const std::string& device) {
+	BlockDeviceTuning tuning;
+	auto queue = SYS_BLOCK_DIR + "/" + device + "/queue/";
+
+	schedulers[device].clear();
+	auto line = StringUtils::trim(FileUtils::readFileContent(queue + "scheduler"));
+	for (auto token : StringUtils::split(line, ' ')) {
+		if (token.starts_with("[") && token.ends_with("]")) {
+			token			 = token.substr(1, token.size() - 2);
+			tuning.scheduler = token;
+		}
+		if (!token.empty()) {
+			schedulers[device].emplace_back(token);
+		}
+	}
+
+	tuning.readAheadKb = readInt(queue + "read_ahead_kb");
+	tuning.nrRequests  = readInt(queue + "nr_requests");
+	tuning.wbtLatUsec  = readInt(queue + "wbt_lat_usec");
+	tuning.rqAffinity  = readInt(queue + "rq_affinity");
+
+	return tuning;
+}
+
+std::optional<std::string> BlockDeviceClient::resolveDevice(const std::string& path) {
+	struct stat st;
+	if (stat(path.c_str(), &st) != 0) {
+		return std::nullopt;
+	}
+
+	std::error_code ec;
+	auto devPath = "/sys/dev/block/" + std::to_string(major(st.st_dev)) + ":" + std::to_string(minor(st.st_dev));
+	auto sysPath = std::filesystem::canonical(devPath, ec);
+	if (ec) {
+		return std::nullopt;
+	}
+
+	// Device mapper (LUKS, LVM) volumes are resolved to the first physical device below them
+	while (FileUtils::exists(sysPath / "slaves") && !std::filesystem::is_empty(sysPath / "slaves")) {
+		auto slave = *std::filesystem::directory_iterator(sysPath / "slaves");
+		sysPath	   = std::filesystem::canonical(slave.path(), ec);
+		if (ec) {
+			return std::nullopt;
+		}
+	}
+
+	if (FileUtils::exists(sysPath / "partition")) {
+		sysPath = sysPath.parent_path();
+	}
+
+	auto name = sysPath.filename().string();
+	if (std::find(devices.begin(), devices.end(), name) == devices.end()) {
+		return std::nullopt;
+	}
+	return name;
+}
+
+std::set<std::string> BlockDeviceClient::resolveSteamDevices() {
+	std::set<std::string> result;
+
+	std::vector<std::string> paths = {Constants::HOME_DIR + "/.steam/steam"};
+	if (FileUtils::exists(Constants::STEAM_LIBRARIES_FILE)) {
+		try {
+			const std::regex pathRegex(R"RE("path"\s+"([^"]+)")RE");
+			auto content = FileUtils::readFileContent(Constants::STEAM_LIBRARIES_FILE);
+			for (std::sregex_iterator it(content.begin(), content.end(), pathRegex), end; it != end; ++it) {
+				paths.emplace_back((*it)[1].str());
+			}
+		} catch (std::exception& e) {
+			logger->error("Error while reading Steam libraries: {}", e.what());
+		}
+	}
+
+	for (const auto& path : paths) {
+		auto device = resolveDevice(path);
+		if (device.has_value()) {
+			result.insert(*device);
+		}
+	}
+
+	return result;
+}
+
+void BlockDeviceClient::setDefaults(const std::string& prefix, const BlockDeviceTuning& tuning) {
+	for (const auto& device : devices) {
+		if (device.starts_with(prefix)) {
+			defaults[device].merge(tuning);
+		}
+	}
+}
+
+void BlockDeviceClient::apply(const IoPreset& preset) {
+	for (const auto& device : devices) {
+		BlockDeviceTuning target = defaults[device];
+		if (preset.contains(BlockDeviceTuning::ALL_DEVICES)) {
+			target.merge(preset.at(BlockDeviceTuning::ALL_DEVICES));
+		}
+		if (steamDevices.contains(device) && preset.contains(BlockDeviceTuning::STEAM_DEVICES)) {
+			target.merge(preset.at(BlockDeviceTuning::STEAM_DEVICES));
+		}
+		if (preset.contains(device)) {
+			target.merge(preset.at(device));
+		}
+
+		auto& actual = current[device];
+		if (target == actual) {
+			continue;
+		}
+
+		auto queue = SYS_BLOCK_DIR + "/" + device + "/queue/";
+		std::vector<std::string> changes, commands;
+		auto addChange = [&](const std::string& attr, const std::string& value) {
+			changes.emplace_back(attr + "=" + value);
+			commands.emplace_back("echo '" + value + "' | tee " + queue + attr);
+		};
+
+		if (target.scheduler.has_value() && target.scheduler != actual.scheduler) {
+			const auto& available = schedulers[device];
+			if (std::find(available.begin(), available.end(), *target.scheduler) != available.end()) {
+				addChange("scheduler", *target.scheduler);
+				// Switching the elevator resets the queue depth
+				actual.nrRequests = std::nullopt;
+			} else {
+				logger->warn("Scheduler {} not available for {}", *target.scheduler, device);
+				target.scheduler = actual.scheduler;
+			}
+		}
+		if (target.nrRequests.has_value() && target.nrRequests != actual.nrRequests) {
+			addChange("nr_requests", std::to_string(*target.nrRequests));
+		}
+		if (target.readAheadKb.has_value() && target.readAheadKb != actual.readAheadKb) {
+			addChange("read_ahead_kb", std::to_string(*target.readAheadKb));
+		}
+		if (target.wbtLatUsec.has_value() && target.wbtLatUsec != actual.wbtLatUsec) {
+			addChange("wbt_lat_usec", std::to_string(*target.wbtLatUsec));
+		}
+		if (target.rqAffinity.has_value() && target.rqAffinity != actual.rqAffinity) {
+			addChange("rq_affinity", std::to_string(*target.rqAffinity));
+		}
+
+		if (commands.empty()) {
+			continue;
+		}
+
+		logger->info("{}: {}", device, StringUtils::join(changes, ", "));
+		try {
+			shell.run_elevated_command(StringUtils::join(commands, " && "));
+			actual = target;
+		} catch (std::exception& e) {
+			logger->error("Error while tuning {}: {}", device, e.what());
+			actual = readTuning(device);
+		}
+	}
+}
@@ -40,8 +40,4 @@ std::string SsdSchedulerClient::getCurrentScheduler() {
 
 std::vector<std::string> SsdSchedulerClient::getAvailableSchedulers() {
 	return schedulers;
-}
-
-void SsdSchedulerClient::setSchedulers(const std::string& sched) {
-	write(sched);
 }
\ No newline at end of file
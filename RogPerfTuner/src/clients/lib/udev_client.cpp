@@ -1,113 +1,173 @@
 #include "clients/lib/udev_client.hpp"
 
-UdevClient::UdevClient() {
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+UdevClient::UdevClient() : Loggable("UdevClient") {
 	udev = udev_new();
 	if (!udev) {
 		throw std::runtime_error("Couldn't initialize udev client");
 	}
 
+	wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (wakeFd < 0) {
+		udev_unref(udev);
+		throw std::runtime_error("Couldn't create udev wake up descriptor");
+	}
+
+	// Receiving is enabled before enumerating, a device plugged in between shows up as a no-op add
 	mon = udev_monitor_new_from_netlink(udev, "udev");
 	udev_monitor_filter_add_match_subsystem_devtype(mon, "usb", "usb_device");
 	udev_monitor_enable_receiving(mon);
 	fd = udev_monitor_get_fd(mon);
 
-	stop   = false;
-	runner = std::thread([this]() {
-		while (!stop) {
-			fd_set fds;
-			FD_ZERO(&fds);
-			FD_SET(fd, &fds);
-
-			int ret = select(fd + 1, &fds, NULL, NULL, NULL);
-			if (ret > 0 && FD_ISSET(fd, &fds)) {
-				struct udev_device* dev = udev_monitor_receive_device(mon);
-				if (dev) {
-					udev_device_unref(dev);
-				}
-				eventBus.emitDeviceEvent();
+	struct udev_enumerate* enumerate = udev_enumerate_new(udev);
+	udev_enumerate_add_match_subsystem(enumerate, "usb");
+	udev_enumerate_add_match_property(enumerate, "DEVTYPE", "usb_device");
+	udev_enumerate_scan_devices(enumerate);
+
+	struct udev_list_entry* entry;
+	udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(enumerate)) {
+		struct udev_device* dev = udev_device_new_from_syspath(udev, udev_list_entry_get_name(entry));
+		if (dev) {
+			auto usb_dev = readIdentifier(dev);
+			if (usb_dev.has_value()) {
+				devices[udev_device_get_devpath(dev)] = *usb_dev;
 			}
+			udev_device_unref(dev);
 		}
-	});
+	}
+	udev_enumerate_unref(enumerate);
+
+	stop   = false;
+	runner = std::thread(&UdevClient::monitorLoop, this);
 }
 
 UdevClient::~UdevClient() {
-	stop = true;
+	stop		 = true;
+	uint64_t one = 1;
+	if (write(wakeFd, &one, sizeof(one)) < 0) {
+		logger->error("Error while waking up udev monitor: {}", std::strerror(errno));
+	}
 	if (runner.joinable()) {
 		runner.join();
 	}
+	close(wakeFd);
 	udev_monitor_unref(mon);
 	udev_unref(udev);
 }
 
 const std::vector<UsbIdentifier> UdevClient::get_usb_dev(const std::function<bool(const UsbIdentifier&)>& dev_filter) {
-	std::vector<UsbIdentifier> devices;
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<UsbIdentifier> result;
+	for (auto& [path, usb_dev] : devices) {
+		if (!dev_filter || dev_filter(usb_dev)) {
+			result.push_back(usb_dev);
+		}
+	}
+	return result;
+}
 
-	struct udev_enumerate* enumerate = udev_enumerate_new(udev);
-	udev_enumerate_add_match_subsystem(enumerate, "usb");
-	udev_enumerate_scan_devices(enumerate);
+void UdevClient::monitorLoop() {
+	// State of every devpath touched by the current burst, nullopt if it ended removed
+	std::unordered_map<std::string, std::optional<UsbIdentifier>> burst;
+	auto burstStart = std::chrono::steady_clock::now();
+
+	pollfd fds[2] = {{fd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+	while (!stop) {
+		int timeout = -1;
+		if (!burst.empty()) {
+			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - burstStart).count();
+			timeout		 = std::max<int>(0, std::min<int>(DEBOUNCE_MS, MAX_DEBOUNCE_MS - elapsed));
+		}
 
-	struct udev_list_entry* devices_list = udev_enumerate_get_list_entry(enumerate);
-	struct udev_list_entry* entry;
+		int ret = poll(fds, 2, timeout);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			logger->error("Error while waiting for udev events: {}", std::strerror(errno));
+			break;
+		}
+		if (fds[1].revents & POLLIN) {
+			break;
+		}
 
-	udev_list_entry_foreach(entry, devices_list) {
-		const char* path		= udev_list_entry_get_name(entry);
-		struct udev_device* dev = udev_device_new_from_syspath(udev, path);
+		if (ret > 0 && (fds[0].revents & POLLIN)) {
+			if (burst.empty()) {
+				burstStart = std::chrono::steady_clock::now();
+			}
+			receive(burst);
+		}
 
-		// Solo dispositivos de tipo "usb_device" (no interfaces)
-		if (dev && std::string(udev_device_get_devtype(dev) ? udev_device_get_devtype(dev) : "") == "usb_device") {
-			const char* vendor		 = udev_device_get_sysattr_value(dev, "idVendor");
-			const char* product		 = udev_device_get_sysattr_value(dev, "idProduct");
-			const char* product_name = udev_device_get_sysattr_value(dev, "product");
+		if (!burst.empty() && (ret == 0 || timeout == 0)) {
+			flush(burst);
+		}
+	}
+}
 
-			if (vendor && product) {
-				UsbIdentifier usb_dev{vendor, product, product_name ? product_name : "Unknown USB device"};
+void UdevClient::receive(std::unordered_map<std::string, std::optional<UsbIdentifier>>& burst) {
+	struct udev_device* dev = udev_monitor_receive_device(mon);
+	if (!dev) {
+		return;
+	}
 
-				if (!dev_filter || dev_filter(usb_dev)) {
-					devices.push_back(usb_dev);
-				}
+	const char* action	= udev_device_get_action(dev);
+	const char* devpath = udev_device_get_devpath(dev);
+	if (action && devpath) {
+		if (std::strcmp(action, "add") == 0) {
+			auto usb_dev = readIdentifier(dev);
+			if (usb_dev.has_value()) {
+				burst[devpath] = usb_dev;
 			}
+		} else if (std::strcmp(action, "remove") == 0) {
+			burst[devpath] = std::nullopt;
 		}
-		udev_device_unref(dev);
 	}
-
-	udev_enumerate_unref(enumerate);
-
-	return devices;
+	udev_device_unref(dev);
 }
 
-const std::tuple<std::vector<UsbIdentifier>, std::vector<UsbIdentifier>, std::vector<UsbIdentifier>> UdevClient::compare_connected_devs(
-	const std::vector<UsbIdentifier>& previous, const std::function<bool(const UsbIdentifier&)>& dev_filter) {
-	auto current_usb = get_usb_dev(dev_filter);
+void UdevClient::flush(std::unordered_map<std::string, std::optional<UsbIdentifier>>& burst) {
 	std::vector<UsbIdentifier> added;
 	std::vector<UsbIdentifier> removed;
-
-	// Detectar añadidos
-	for (const auto& dev1 : current_usb) {
-		bool found = false;
-		for (const auto& dev2 : previous) {
-			if (dev1.id_vendor == dev2.id_vendor && dev1.id_product == dev2.id_product) {
-				found = true;
-				break;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto& [path, state] : burst) {
+			auto it = devices.find(path);
+			if (state.has_value() && it == devices.end()) {
+				devices[path] = *state;
+				added.push_back(*state);
+			} else if (state.has_value() && it->second != *state) {
+				// Another device took the port within the burst, it is reported as unplugged and plugged
+				removed.push_back(it->second);
+				added.push_back(*state);
+				it->second = *state;
+			} else if (!state.has_value() && it != devices.end()) {
+				removed.push_back(it->second);
+				devices.erase(it);
 			}
 		}
-		if (!found) {
-			added.push_back(dev1);
-		}
 	}
+	burst.clear();
 
-	// Detectar eliminados
-	for (const auto& dev1 : previous) {
-		bool found = false;
-		for (const auto& dev2 : current_usb) {
-			if (dev1.id_vendor == dev2.id_vendor && dev1.id_product == dev2.id_product) {
-				found = true;
-				break;
-			}
-		}
-		if (!found) {
-			removed.push_back(dev1);
-		}
+	if (!added.empty() || !removed.empty()) {
+		eventBus.emitDeviceEvent(added, removed);
 	}
+}
 
-	return {current_usb, added, removed};
-}
\ No newline at end of file
+std::optional<UsbIdentifier> UdevClient::readIdentifier(struct udev_device* dev) {
+	const char* vendor		 = udev_device_get_sysattr_value(dev, "idVendor");
+	const char* product		 = udev_device_get_sysattr_value(dev, "idProduct");
+	const char* product_name = udev_device_get_sysattr_value(dev, "product");
+	if (!vendor || !product) {
+		return std::nullopt;
+	}
+	return UsbIdentifier{vendor, product, product_name ? product_name : "Unknown USB device"};
+}
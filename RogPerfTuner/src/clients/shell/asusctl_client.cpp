@@ -57,5 +57,9 @@ std::vector<std::string> AsusCtlClient::getFans(PlatformProfile profile) {
 #endif
 
 void AsusCtlClient::turnOffAura() {
-	run_command("aura effect static --colour 000000", true, false);
+	setAuraColor("000000");
+}
+
+void AsusCtlClient::setAuraColor(const std::string& color) {
+	run_command("aura effect static --colour " + (color.starts_with("#") ? color.substr(1) : color), true, false);
 }
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "clients/tcp/open_rgb/audio/audio_capture.hpp"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#include "clients/tcp/open_rgb/audio/spectrum_analyzer.hpp"
+
+extern char** environ;
+
+namespace {
+template <typename T>
+T readLe(const std::vector<char>& data, size_t pos) {
+	T value{};
+	std::memcpy(&value, data.data() + pos, sizeof(T));
+	return value;
+}
+}  // namespace
+
+AudioCapture::AudioCapture() : Loggable("AudioCapture") {
+	for (auto& buffer : _buffers) {
+		buffer.assign(BANDS, 0);
+	}
+}
+
+AudioCapture::~AudioCapture() {
+	stop();
+}
+
+void AudioCapture::start(const std::optional<std::string>& wavFile) {
+	stop();
+
+	_running = true;
+	if (wavFile.has_value()) {
+		logger->info("Capturing audio from {}", *wavFile);
+		_thread = std::thread(&AudioCapture::captureWav, this, *wavFile);
+		return;
+	}
+
+	int fds[2];
+	if (pipe2(fds, O_CLOEXEC) != 0) {
+		logger->error("Error while creating audio pipe: {}", std::strerror(errno));
+		_running = false;
+		return;
+	}
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+
+	std::vector<std::string> args = {"parec", "--device=@DEFAULT_MONITOR@", "--format=float32le", "--channels=1", "--raw", "--latency-msec=10"};
+	args.push_back("--rate=" + std::to_string(SAMPLE_RATE));
+	std::vector<char*> argv;
+	for (auto& arg : args) {
+		argv.push_back(arg.data());
+	}
+	argv.push_back(nullptr);
+
+	auto res = posix_spawnp(&_pid, "parec", &actions, nullptr, argv.data(), environ);
+	posix_spawn_file_actions_destroy(&actions);
+	close(fds[1]);
+
+	if (res != 0) {
+		logger->error("Error while launching parec: {}", std::strerror(res));
+		close(fds[0]);
+		_pid	 = -1;
+		_running = false;
+		return;
+	}
+
+	logger->info("Capturing audio from default monitor");
+	_fd		= fds[0];
+	_thread = std::thread(&AudioCapture::captureMonitor, this);
+}
+
+void AudioCapture::stop() {
+	if (!_running && !_thread.joinable()) {
+		return;
+	}
+
+	_running = false;
+	if (_pid > 0) {
+		kill(_pid, SIGTERM);
+	}
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+	if (_pid > 0) {
+		waitpid(_pid, nullptr, 0);
+		_pid = -1;
+	}
+	if (_fd >= 0) {
+		close(_fd);
+		_fd = -1;
+	}
+	logger->info("Audio capture stopped");
+}
+
+bool AudioCapture::read(std::vector<float>& levels) {
+	if ((_middle.load(std::memory_order_acquire) & DIRTY) == 0) {
+		return false;
+	}
+
+	_front = _middle.exchange(_front, std::memory_order_acq_rel) & ~DIRTY;
+	levels.assign(_buffers[_front].begin(), _buffers[_front].end());
+	return true;
+}
+
+void AudioCapture::publish(const std::vector<float>& levels) {
+	std::copy(levels.begin(), levels.end(), _buffers[_back].begin());
+	_back = _middle.exchange(_back | DIRTY, std::memory_order_acq_rel) & ~DIRTY;
+}
+
+void AudioCapture::captureMonitor() {
+	SpectrumAnalyzer analyzer(WINDOW, HOP, SAMPLE_RATE, BANDS);
+	std::vector<float> samples(HOP);
+	std::vector<float> levels(BANDS);
+
+	// parec writes whole float samples but a read may still end in the middle of one
+	auto buffer	  = reinterpret_cast<char*>(samples.data());
+	size_t filled = 0;
+	while (_running) {
+		auto bytes = ::read(_fd, buffer + filled, (HOP * sizeof(float)) - filled);
+		if (bytes <= 0) {
+			break;
+		}
+		filled += bytes;
+		if (filled < HOP * sizeof(float)) {
+			continue;
+		}
+		filled = 0;
+
+		if (analyzer.push(samples)) {
+			auto current = analyzer.levels();
+			levels.assign(current.begin(), current.end());
+			publish(levels);
+		}
+	}
+
+	if (_running) {
+		logger->warn("Audio capture ended unexpectedly");
+	}
+}
+
+void AudioCapture::captureWav(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	if (data.size() < 12 || std::memcmp(data.data(), "RIFF", 4) != 0 || std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+		logger->error("Error while reading {}: not a WAV file", path);
+		return;
+	}
+
+	uint16_t format	  = 0;
+	uint16_t channels = 0;
+	uint16_t bits	  = 0;
+	uint32_t rate	  = 0;
+	std::vector<float> mono;
+	for (size_t pos = 12; pos + 8 <= data.size();) {
+		auto size  = readLe<uint32_t>(data, pos + 4);
+		auto start = pos + 8;
+		if (std::memcmp(data.data() + pos, "fmt ", 4) == 0 && size >= 16) {
+			format	 = readLe<uint16_t>(data, start);
+			channels = readLe<uint16_t>(data, start + 2);
+			rate	 = readLe<uint32_t>(data, start + 4);
+			bits	 = readLe<uint16_t>(data, start + 14);
+		} else if (std::memcmp(data.data() + pos, "data", 4) == 0 && channels > 0) {
+			bool pcm16	 = format == 1 && bits == 16;
+			bool float32 = format == 3 && bits == 32;
+			if (!pcm16 && !float32) {
+				break;
+			}
+			size_t frame = channels * (bits / 8);
+			for (size_t f = start; f + frame <= std::min<size_t>(start + size, data.size()); f += frame) {
+				float sum = 0;
+				for (size_t c = 0; c < channels; c++) {
+					sum += pcm16 ? readLe<int16_t>(data, f + (c * 2)) / 32768.0f : readLe<float>(data, f + (c * 4));
+				}
+				mono.push_back(sum / channels);
+			}
+		}
+		pos = start + size + (size % 2);
+	}
+
+	if (mono.empty() || rate == 0) {
+		logger->error("Error while reading {}: only 16 bit PCM and 32 bit float WAV files are supported", path);
+		return;
+	}
+
+	SpectrumAnalyzer analyzer(WINDOW, HOP, rate, BANDS);
+	std::vector<float> levels(BANDS);
+	auto hopTime = std::chrono::duration<double>(static_cast<double>(HOP) / rate);
+	auto next	 = std::chrono::steady_clock::now();
+
+	// Played in real time so latency matches a live capture
+	size_t pos = 0;
+	while (_running) {
+		if (pos + HOP > mono.size()) {
+			pos = 0;
+		}
+		if (analyzer.push(std::span<const float>(mono).subspan(pos, std::min(HOP, mono.size())))) {
+			auto current = analyzer.levels();
+			levels.assign(current.begin(), current.end());
+			publish(levels);
+		}
+		pos += HOP;
+
+		next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(hopTime);
+		std::this_thread::sleep_until(next);
+	}
+}
@@ -0,0 +1,120 @@
+#include "clients/tcp/open_rgb/audio/spectrum_analyzer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+SpectrumAnalyzer::SpectrumAnalyzer(size_t size, size_t hop, uint32_t sampleRate, size_t bands)
+	: _size(size), _hop(hop), _pending(hop), _history(size, 0), _window(size), _data(size / 2), _split(size / 2 + 1), _levels(bands, 0) {
+	auto half = size / 2;
+
+	for (size_t i = 0; i < size; i++) {
+		_window[i] = 0.5f * (1 - std::cos(2 * std::numbers::pi * i / (size - 1)));
+	}
+
+	uint32_t bits = 0;
+	while ((1UL << bits) < half) {
+		bits++;
+	}
+	_reversed.resize(half);
+	for (uint32_t i = 0; i < half; i++) {
+		uint32_t rev = 0;
+		for (uint32_t b = 0; b < bits; b++) {
+			rev |= ((i >> b) & 1) << (bits - 1 - b);
+		}
+		_reversed[i] = rev;
+	}
+
+	_twiddles.resize(half / 2);
+	for (size_t k = 0; k < half / 2; k++) {
+		_twiddles[k] = std::polar(1.0f, static_cast<float>(-2 * std::numbers::pi * k / half));
+	}
+	for (size_t k = 0; k <= half; k++) {
+		_split[k] = std::polar(1.0f, static_cast<float>(-2 * std::numbers::pi * k / size));
+	}
+
+	// Logarithmic band edges as FFT bins, each band at least one bin wide
+	double maxFreq = std::min(MAX_FREQ, sampleRate / 2.0);
+	_edges.resize(bands + 1);
+	for (size_t b = 0; b <= bands; b++) {
+		auto freq = MIN_FREQ * std::pow(maxFreq / MIN_FREQ, static_cast<double>(b) / bands);
+		_edges[b] = std::clamp<size_t>(static_cast<size_t>(freq * size / sampleRate), 1, half);
+		if (b > 0 && _edges[b] <= _edges[b - 1]) {
+			_edges[b] = std::min(_edges[b - 1] + 1, half);
+		}
+	}
+}
+
+bool SpectrumAnalyzer::push(std::span<const float> samples) {
+	bool analyzed = false;
+	for (auto sample : samples) {
+		_history[_position]	= sample;
+		_position			= (_position + 1) % _size;
+		if (--_pending == 0) {
+			analyze();
+			_pending = _hop;
+			analyzed = true;
+		}
+	}
+	return analyzed;
+}
+
+std::span<const float> SpectrumAnalyzer::levels() const {
+	return _levels;
+}
+
+void SpectrumAnalyzer::analyze() {
+	// Even samples go to the real part and odd ones to the imaginary part, so a half size complex FFT does the job
+	auto half = _size / 2;
+	for (size_t n = 0; n < half; n++) {
+		auto even = (_position + (2 * n)) % _size;
+		auto odd  = (even + 1) % _size;
+		_data[n]  = {_history[even] * _window[2 * n], _history[odd] * _window[(2 * n) + 1]};
+	}
+	fft();
+
+	float scale = 4.0f / _size;
+	float loud	= 0;
+	for (size_t b = 0; b + 1 < _edges.size(); b++) {
+		float power = 0;
+		for (size_t k = _edges[b]; k < _edges[b + 1]; k++) {
+			auto z	= _data[k % half];
+			auto zc = std::conj(_data[(half - k) % half]);
+			auto x	= ((z + zc) * 0.5f) + (_split[k] * (z - zc) * std::complex<float>(0, -0.5f));
+			power += std::norm(x * scale);
+		}
+		power /= static_cast<float>(_edges[b + 1] - _edges[b]);
+
+		auto db	   = 10 * std::log10(power + 1e-12f);
+		_levels[b] = std::clamp(static_cast<float>((db - FLOOR_DB) / RANGE_DB), 0.0f, 1.0f);
+		loud	   = std::max(loud, _levels[b]);
+	}
+
+	// Slow automatic gain so quiet sources still fill the range
+	_peak = std::max(loud, static_cast<float>(_peak * PEAK_FALL));
+	if (_peak > 0.1f) {
+		for (auto& level : _levels) {
+			level = std::min(1.0f, level / _peak);
+		}
+	}
+}
+
+void SpectrumAnalyzer::fft() {
+	auto n = _data.size();
+	for (size_t i = 0; i < n; i++) {
+		if (i < _reversed[i]) {
+			std::swap(_data[i], _data[_reversed[i]]);
+		}
+	}
+
+	for (size_t len = 2; len <= n; len <<= 1) {
+		auto step = n / len;
+		for (size_t i = 0; i < n; i += len) {
+			for (size_t j = 0; j < len / 2; j++) {
+				auto t					 = _twiddles[j * step] * _data[i + j + (len / 2)];
+				_data[i + j + (len / 2)] = _data[i + j] - t;
+				_data[i + j]			 = _data[i + j] + t;
+			}
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#include "clients/tcp/open_rgb/effects/audio_spectrum_effect.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "clients/tcp/open_rgb/render/color_kernels.hpp"
+
+AudioSpectrumEffect::AudioSpectrumEffect() : AbstractEffect("Audio spectrum") {
+	_min_fps = 30;
+	_max_fps = 60;
+}
+
+void AudioSpectrumEffect::prepare(const DeviceList& devices, const GeometryIndex& geometry) {
+	// Bands go from left to right over the canvas, low frequencies in red up to high ones in violet
+	_input.assign(AudioCapture::BANDS, 0);
+	_levels.assign(AudioCapture::BANDS, 0);
+	_colors.clear();
+	for (size_t b = 0; b < AudioCapture::BANDS; b++) {
+		_colors.push_back(ColorKernels::hue(270.0 * b / AudioCapture::BANDS));
+	}
+
+	// Matrices show bars growing from the bottom row, single rows only change their brightness
+	_maps.clear();
+	for (size_t d = 0; d < devices.size(); d++) {
+		auto positions = geometry.canvasX(d);
+		auto heights   = geometry.y(d);
+		auto rows	   = std::max<uint32_t>(geometry.device(d).rows, 1);
+
+		DeviceMap map{std::vector<int32_t>(positions.size(), -1), std::vector<float>(positions.size(), 0), static_cast<float>(rows)};
+		for (size_t i = 0; i < positions.size(); i++) {
+			if (positions[i] >= 0) {
+				map.bands[i] = std::min<int32_t>(positions[i] * AudioCapture::BANDS, AudioCapture::BANDS - 1);
+				map.rows[i]	 = (rows - 1) - (heights[i] * rows);
+			}
+		}
+		_maps.emplace_back(std::move(map));
+	}
+
+	auto file = std::getenv(AUDIO_FILE_ENV.c_str());
+	_capture.start(file ? std::optional<std::string>(file) : std::nullopt);
+}
+
+void AudioSpectrumEffect::tick(const FrameTime& time) {
+	// Levels rise instantly and fall at a fixed rate so beats stay visible
+	_capture.read(_input);
+	auto fall = static_cast<float>(_fall * time.delta);
+	for (size_t b = 0; b < _levels.size(); b++) {
+		_levels[b] = std::max(_input[b], _levels[b] - fall);
+	}
+}
+
+void AudioSpectrumEffect::render(const FrameTime&, const Device&, size_t devIdx, std::span<Color> leds) {
+	auto& map = _maps[devIdx];
+	for (size_t i = 0; i < leds.size(); i++) {
+		if (map.bands[i] < 0) {
+			continue;
+		}
+		auto band = map.bands[i];
+		leds[i]	  = ColorKernels::scale(_colors[band], std::clamp((_levels[band] * map.height) - map.rows[i], 0.0f, 1.0f));
+	}
+}
+
+void AudioSpectrumEffect::finish() {
+	_capture.stop();
+}
@@ -2,33 +2,22 @@
 
 #include <math.h>
 
-void BreathingEffect::apply_effect(const DeviceList& devices) {
-	int offset = 0;
-	while (_is_running) {
-		Color new_color = *_color * _sin_steps[offset];
+#include <algorithm>
 
-		for (auto& dev : devices) {
-			if (dev.enabled) {
-				std::vector<Color> colors(dev.leds.size(), new_color);
-				_set_colors(dev, colors);
-			}
-		}
+#include "clients/tcp/open_rgb/render/color_kernels.hpp"
 
-		offset = (offset + 1) % _step_count;
+void BreathingEffect::tick(const FrameTime& time) {
+	double phase  = std::fmod(time.elapsed, _total_time);
+	double active = _total_time - _pause_time;
 
-		if (offset > 0) {
-			_sleep(_frequency);
-		} else {
-			_sleep(_pause_time);
-		}
-	}
+	_current = phase < active ? ColorKernels::scale(_color.load(), std::sin(M_PI * phase / active)) : Color::Black;
 }
 
-BreathingEffect::BreathingEffect(Client& client)
-	: AbstractEffect(client, "Breathing", Color::Red.toHex()), _total_time(4.0), _pause_time(1.0), _frequency(0.05) {
-	_step_count = static_cast<int>((_total_time - _pause_time) / _frequency);
-	_sin_steps.reserve(_step_count);
-	for (int offset = 0; offset < _step_count; ++offset) {
-		_sin_steps.push_back(std::sin(M_PI * (static_cast<double>(offset) / (_step_count - 1))));
-	}
-}
\ No newline at end of file
+void BreathingEffect::render(const FrameTime&, const Device&, size_t, std::span<Color> leds) {
+	std::fill(leds.begin(), leds.end(), _current);
+}
+
+BreathingEffect::BreathingEffect() : AbstractEffect("Breathing", Color::Red.toHex()), _total_time(4.0), _pause_time(1.0) {
+	_min_fps = 20;
+	_max_fps = 60;
+}
@@ -1,5 +1,9 @@
 #include "clients/tcp/open_rgb/effects/dance_floor_effect.hpp"
 
+#include <cmath>
+
+#include "clients/tcp/open_rgb/render/color_kernels.hpp"
+
 Color DanceFloorEffect::_get_random_color() {
 	std::uniform_int_distribution<int> hue_dist(0, 359);
 	std::uniform_int_distribution<int> sat_dist(80, 100);
@@ -9,30 +13,35 @@ Color DanceFloorEffect::_get_random_color() {
 	int s = sat_dist(_rng);
 	int v = val_dist(_rng);
 
-	return Color::fromHsv(h, s / 100.0, v / 100.0);
+	return ColorKernels::hsv(h, s / 100.0, v / 100.0);
 }
 
-std::vector<Color> DanceFloorEffect::_get_random_colors(size_t length) {
-	std::vector<Color> colors;
-	colors.reserve(length);
-	for (size_t i = 0; i < length; ++i) {
-		colors.push_back(_get_random_color());
-	}
-	return colors;
+DanceFloorEffect::DanceFloorEffect() : AbstractEffect("Dance floor") {
+	_min_fps = 2;
+	_max_fps = 4;
+}
+
+void DanceFloorEffect::prepare(const DeviceList& devices, const GeometryIndex&) {
+	_generation = 0;
+	_rendered.assign(devices.size(), UINT64_MAX);
+}
+
+void DanceFloorEffect::remap(const DeviceList&, const GeometryIndex&, const std::vector<std::optional<size_t>>& previous) {
+	// Devices that stay keep their colors until the next beat, new ones are painted right away
+	_rendered = carryOver(_rendered, previous, [](size_t) {
+		return UINT64_MAX;
+	});
 }
 
-DanceFloorEffect::DanceFloorEffect(Client& client) : AbstractEffect(client, "Dance floor") {
-	std::random_device rd;
-	_rng = std::mt19937(rd());
+void DanceFloorEffect::tick(const FrameTime& time) {
+	_generation = static_cast<uint64_t>(std::floor(time.elapsed / _interval));
 }
 
-void DanceFloorEffect::apply_effect(const DeviceList& devices) {
-	while (_is_running) {
-		for (auto& dev : devices) {
-			if (dev.enabled) {
-				_set_colors(dev, _get_random_colors(dev.leds.size()));
-			}
+void DanceFloorEffect::render(const FrameTime&, const Device&, size_t devIdx, std::span<Color> leds) {
+	if (_rendered[devIdx] != _generation) {
+		for (auto& led : leds) {
+			led = _get_random_color();
 		}
-		_sleep(0.5);
+		_rendered[devIdx] = _generation;
 	}
-}
\ No newline at end of file
+}
@@ -2,45 +2,30 @@
 
 #include <algorithm>
 #include <cmath>
-#include <thread>
-
-#include "framework/models/cpu_usage.hpp"
-
-std::vector<std::vector<DigitalRainEffect::LedStatus>> DigitalRainEffect::_dev_to_mat(Device& dev) {
-	std::vector<std::vector<LedStatus>> mat_def;
-	uint32_t offset	   = 0;
-	uint32_t last_leds = 0;
-
-	for (auto& zone : dev.zones) {
-		if (zone.type == orgb::ZoneType::Matrix) {
-			bool has_only_last = false;
-			for (size_t r = 0; r < zone.matrix_height; ++r) {
-				std::vector<LedStatus> row;
-				for (size_t c = 0; c < zone.matrix_width; ++c) {
-					if (zone.matrix_values[(r * zone.matrix_width) + c] != DigitalRainEffect::LedStatus::INVALID_LED) {
-						row.push_back(LedStatus{offset + static_cast<int>(zone.matrix_values[(r * zone.matrix_width) + c])});
-					} else {
-						row.push_back(LedStatus{DigitalRainEffect::LedStatus::INVALID_LED});
-					}
-				}
-				mat_def.push_back(row);
-			}
-		} else {
-			std::vector<LedStatus> row;
-			for (size_t l = 0; l < zone.leds_count; ++l) {
-				row.push_back(LedStatus{static_cast<unsigned int>(offset + l)});
-			}
-			mat_def.push_back(row);
+
+#include "clients/tcp/open_rgb/render/color_kernels.hpp"
+
+std::vector<std::vector<DigitalRainEffect::LedStatus>> DigitalRainEffect::_dev_to_mat(const Device& dev, size_t devIdx,
+																						  const GeometryIndex& geometry) {
+	auto& layout = geometry.device(devIdx);
+	std::vector<std::vector<LedStatus>> mat_def(layout.rows, std::vector<LedStatus>(layout.columns));
+	for (uint32_t r = 0; r < layout.rows; ++r) {
+		for (uint32_t c = 0; c < layout.columns; ++c) {
+			mat_def[r][c].pos_idx = geometry.at(devIdx, r, c);
 		}
-		offset += static_cast<int>(zone.leds_count);
-		last_leds = static_cast<int>(zone.leds_count);
 	}
 
-	if (dev.type == orgb::DeviceType::Mouse) {
-		offset -= last_leds;
+	// Mouse LEDs are numbered backwards, the last zone is left out of the rain
+	if (dev.type == orgb::DeviceType::Mouse && !dev.zones.empty()) {
+		uint32_t offset = 0;
+		for (size_t z = 0; z + 1 < dev.zones.size(); z++) {
+			offset += dev.zones[z].leds_count;
+		}
 		for (auto& row : mat_def) {
 			for (auto& led : row) {
-				led.pos_idx = offset - led.pos_idx;
+				if (led.pos_idx != LedStatus::INVALID_LED) {
+					led.pos_idx = offset - led.pos_idx;
+				}
 			}
 		}
 	}
@@ -101,58 +86,34 @@ void DigitalRainEffect::_get_next_matrix(std::vector<std::vector<LedStatus>>& zo
 		int allowed = std::max(1, (int)std::ceil(zone_status[0].size() * _cpu));
 
 		if (allowed > (int)(zone_status[0].size() - free_cols.size())) {
-			int next_col					 = free_cols[std::rand() % free_cols.size()];
+			int next_col					 = free_cols[std::uniform_int_distribution<size_t>(0, free_cols.size() - 1)(_rng)];
 			zone_status[0][next_col].max_val = (int)std::round(_max_count * (1 - (0.25 * _cpu)));
 			zone_status[0][next_col].cur_val = zone_status[0][next_col].max_val;
 		}
 	}
 }
 
-std::vector<Color> DigitalRainEffect::_to_color_matrix(const std::vector<std::vector<LedStatus>>& zone_status, int dev_size) {
-	std::vector<Color> colors(dev_size, Color::Black);
+void DigitalRainEffect::_to_color_matrix(const std::vector<std::vector<LedStatus>>& zone_status, std::span<Color> colors) {
+	auto color = _color.load();
+	std::fill(colors.begin(), colors.end(), Color::Black);
 	for (auto& row : zone_status) {
 		for (auto& led : row) {
-			if (led.pos_idx < static_cast<unsigned int>(dev_size)) {
+			if (led.pos_idx < colors.size()) {
 				if (led.cur_val >= led.max_val) {
 					colors[led.pos_idx] = Color::White;
 				} else if (led.cur_val >= int(2 * led.max_val / 3)) {
-					colors[led.pos_idx] = *_color;
+					colors[led.pos_idx] = color;
 				} else {
-					colors[led.pos_idx] = *_color * _sin_array[std::floor(led.cur_val * (_max_count / static_cast<double>(_max_count)))];
+					colors[led.pos_idx] = ColorKernels::scale(color, _sin_array[led.cur_val]);
 				}
 			}
 		}
 	}
-	return colors;
-}
-
-void DigitalRainEffect::device_thread(Device& dev) {
-	auto zone_status = _dev_to_mat(dev);
-	_set_colors(dev, std::vector<Color>(dev.leds.size(), Color::Black));
-	_sleep(std::uniform_int_distribution<int>(0, 500)(_rng) / 1000.0);
-
-	std::uniform_int_distribution<int> hue_dist(0, 359);
-	int hue = hue_dist(_rng);
-
-	while (dev.enabled && _is_running) {
-		_decrement_matrix(zone_status);
-		_get_next_matrix(zone_status);
-		auto final_colors = _to_color_matrix(zone_status, static_cast<int>(dev.leds.size()));
-		_set_colors(dev, final_colors);
-		_sleep(_nap_time * (1 - 0.4 * _cpu));
-	}
-}
-
-void DigitalRainEffect::cpu_thread() {
-	while (_is_running) {
-		_cpu = std::max(0.01, CPUUsage::getUseRate());
-		_sleep(2 * _nap_time);
-	}
 }
 
-DigitalRainEffect::DigitalRainEffect(Client& client) : AbstractEffect(client, "Digital rain", Color::Green.toHex()) {
-	std::random_device rd;
-	_rng = std::mt19937(rd());
+DigitalRainEffect::DigitalRainEffect() : AbstractEffect("Digital rain", Color::Green.toHex()) {
+	_min_fps = 10;
+	_max_fps = 30;
 	_sin_array.resize(2 * _max_count / 3);
 	for (size_t i = 0; i < _sin_array.size(); ++i) {
 		double x	  = (i / static_cast<double>(_max_count + 2)) * M_PI / 2;
@@ -160,21 +121,56 @@ DigitalRainEffect::DigitalRainEffect(Client& client) : AbstractEffect(client, "D
 	}
 }
 
-void DigitalRainEffect::apply_effect(const DeviceList& devices) {
-	std::vector<std::thread> threads;
+void DigitalRainEffect::prepare(const DeviceList& devices, const GeometryIndex& geometry) {
+	_states.clear();
+	for (size_t d = 0; d < devices.size(); d++) {
+		_states.emplace_back(DeviceState{_dev_to_mat(devices[d], d, geometry), std::uniform_int_distribution<int>(0, 500)(_rng) / 1000.0});
+	}
+	_cpu	  = 0.0;
+	_next_cpu = 0;
+	if (!_seed.has_value()) {
+		_last_cpu = CPUUsage::read();
+	}
+}
 
-	// CPU monitor
-	threads.emplace_back([this] {
-		cpu_thread();
+void DigitalRainEffect::remap(const DeviceList& devices, const GeometryIndex& geometry, const std::vector<std::optional<size_t>>& previous) {
+	_states = carryOver(_states, previous, [&](size_t d) {
+		return DeviceState{_dev_to_mat(devices[d], d, geometry), std::uniform_int_distribution<int>(0, 500)(_rng) / 1000.0};
 	});
+}
 
-	for (auto& dev : devices) {
-		threads.emplace_back([this, &dev] {
-			device_thread(dev);
-		});
+void DigitalRainEffect::tick(const FrameTime& time) {
+	// CPU usage is sampled between ticks instead of blocking the render thread
+	if (time.elapsed >= _next_cpu && _seed.has_value()) {
+		// A fixed seed has to render the same frames on any host, so the load follows a synthetic curve
+		_cpu	  = std::max(0.01, 0.5 + (0.4 * std::sin(time.elapsed / 2)));
+		_next_cpu = time.elapsed + (2 * _nap_time);
+	} else if (time.elapsed >= _next_cpu) {
+		auto cpu		= CPUUsage::read();
+		auto total_diff = cpu.total() - _last_cpu.total();
+		if (total_diff > 0) {
+			_cpu = std::max(0.01, static_cast<double>(cpu.active() - _last_cpu.active()) / total_diff);
+		}
+		_last_cpu = cpu;
+		_next_cpu = time.elapsed + (2 * _nap_time);
+	}
+}
+
+void DigitalRainEffect::render(const FrameTime& time, const Device&, size_t devIdx, std::span<Color> leds) {
+	auto& state = _states[devIdx];
+	if (state.matrix.empty() || state.matrix[0].empty()) {
+		return;
 	}
 
-	for (auto& t : threads) {
-		t.join();
+	state.until_next -= time.delta;
+	if (state.until_next > 0) {
+		return;
 	}
-}
\ No newline at end of file
+
+	while (state.until_next <= 0) {
+		_decrement_matrix(state.matrix);
+		_get_next_matrix(state.matrix);
+		state.until_next += _nap_time * (1 - 0.4 * _cpu);
+	}
+	_to_color_matrix(state.matrix, leds);
+}
@@ -1,52 +1,47 @@
 #include "clients/tcp/open_rgb/effects/drops_effect.hpp"
 
-void DropsEffect::apply_effect(const DeviceList& devices) {
+#include <algorithm>
+
+void DropsEffect::prepare(const DeviceList& devices, const GeometryIndex&) {
 	_buffer.clear();
 	_buffer.resize(devices.size());
-	std::vector<std::thread> threads;
-
-	int i = 0;
-	for (auto& dev : devices) {
-		_buffer[i].clear();
-		threads.emplace_back([this, &dev, i]() {
-			this->_effect_thread(i, dev);
-		});
-		i++;
-	}
-
-	for (auto& t : threads) {
-		if (t.joinable()) {
-			t.join();
-		}
-	}
+	_until_next.assign(devices.size(), 0);
 }
 
-DropsEffect::DropsEffect(Client& client) : AbstractEffect(client, "Drops") {
-	_available_colors = {Color{0, 0, 0}, Color{0, 0, 0}, Color{255, 255, 255}, Color{255, 0, 0}, Color{0, 255, 255}};
+void DropsEffect::remap(const DeviceList&, const GeometryIndex&, const std::vector<std::optional<size_t>>& previous) {
+	_buffer = carryOver(_buffer, previous, [](size_t) {
+		return std::vector<LedTask>{};
+	});
+	_until_next = carryOver(_until_next, previous, [](size_t) {
+		return 0.0;
+	});
 }
 
-void DropsEffect::_effect_thread(size_t dev_index, Device& dev) {
-	std::vector<Color> leds(dev.leds.size(), Color::fromRgb("#000000"));
-	while (dev.enabled && _is_running) {
-		auto next_t		   = _get_next(dev_index, dev);
+void DropsEffect::render(const FrameTime& time, const Device& dev, size_t devIdx, std::span<Color> leds) {
+	if (leds.empty()) {
+		return;
+	}
+
+	_until_next[devIdx] -= time.delta;
+	while (_until_next[devIdx] <= 0) {
+		auto next_t		   = _get_next(devIdx, dev);
 		leds[next_t.index] = next_t.color;
-		_set_colors(dev, leds);
-		int naps = 4;
-		for (int i = 0; i < naps; ++i) {
-			if (dev.enabled && _is_running) {
-				double nap_time = 2500.0 / leds.size() / (random_int(6, 10) / 10.0) / naps;
-				_sleep(nap_time / 1000.0);
-			}
-		}
+		_until_next[devIdx] += 2.5 / leds.size() / (random_int(6, 10) / 10.0);
 	}
 }
 
-DropsEffect::LedTask DropsEffect::_get_next(size_t dev_index, Device& dev) {
+DropsEffect::DropsEffect() : AbstractEffect("Drops") {
+	_min_fps		  = 10;
+	_max_fps		  = 30;
+	_available_colors = {Color{0, 0, 0}, Color{0, 0, 0}, Color{255, 255, 255}, Color{255, 0, 0}, Color{0, 255, 255}};
+}
+
+DropsEffect::LedTask DropsEffect::_get_next(size_t dev_index, const Device& dev) {
 	if (_buffer[dev_index].empty()) {
 		for (size_t i = 0; i < dev.leds.size(); ++i) {
 			_buffer[dev_index].push_back({i, _available_colors[random_int(0, _available_colors.size() - 1)]});
 		}
-		std::shuffle(_buffer[dev_index].begin(), _buffer[dev_index].end(), rng);
+		std::shuffle(_buffer[dev_index].begin(), _buffer[dev_index].end(), _rng);
 	}
 
 	LedTask next_t = _buffer[dev_index].front();
@@ -56,5 +51,5 @@ DropsEffect::LedTask DropsEffect::_get_next(size_t dev_index, Device& dev) {
 
 int DropsEffect::random_int(int min, int max) {
 	std::uniform_int_distribution<int> dist(min, max);
-	return dist(rng);
-}
\ No newline at end of file
+	return dist(_rng);
+}
@@ -1,5 +1,7 @@
 #include "clients/tcp/open_rgb/effects/gaming.hpp"
 
+#include <algorithm>
+
 const Color GamingEffect::MAIN_COLOR = Color::fromRgb("#000040");
 
 const std::vector<std::pair<std::regex, Color>> GamingEffect::COLOR_MATCHING = {
@@ -9,28 +11,35 @@ const std::vector<std::pair<std::regex, Color>> GamingEffect::COLOR_MATCHING = {
 	{std::regex("Key: Fan|Key: ROG"), Color::fromRgb("#FF4000")},
 };
 
-GamingEffect::GamingEffect(Client& client) : AbstractEffect(client, "Gaming") {
+GamingEffect::GamingEffect() : AbstractEffect("Gaming") {
+	_min_fps = 1;
+	_max_fps = 1;
 }
 
-void GamingEffect::apply_effect(const DeviceList& devices) {
+void GamingEffect::prepare(const DeviceList& devices, const GeometryIndex&) {
+	_layouts.clear();
 	for (auto& dev : devices) {
 		std::vector<Color> colors(dev.leds.size(), MAIN_COLOR);
-		size_t offset = 0;
 
 		if (dev.type == DeviceType::Keyboard || dev.type == DeviceType::Laptop) {
 			for (auto& led : dev.leds) {
 				for (auto& pair : COLOR_MATCHING) {
 					if (std::regex_match(led.name, pair.first)) {
-						colors[offset + led.idx] = pair.second;
+						colors[led.idx] = pair.second;
 						break;
 					}
 				}
 			}
 		}
 
-		_set_colors(dev, colors);
-	}
-	while (_is_running) {
-		_sleep(1.0);
+		_layouts.emplace_back(std::move(colors));
 	}
 }
+
+std::optional<Color> GamingEffect::getSolidColor() {
+	return MAIN_COLOR;
+}
+
+void GamingEffect::render(const FrameTime&, const Device&, size_t devIdx, std::span<Color> leds) {
+	std::copy(_layouts[devIdx].begin(), _layouts[devIdx].end(), leds.begin());
+}
@@ -1,63 +1,35 @@
 #include "clients/tcp/open_rgb/effects/rainbow_wave.hpp"
 
-#include <math.h>
-
-void RainbowWave::apply_effect(const DeviceList& devices) {
-	// Calcular la longitud de la zona más grande
-	size_t longest_zone = 0;
-	for (auto& dev : devices) {
-		for (auto& zone : dev.zones) {
-			size_t zone_len = (zone.type == orgb::ZoneType::Matrix) ? zone.matrix_width : zone.leds_count;
-			if (zone_len > longest_zone) {
-				longest_zone = zone_len;
+#include "clients/tcp/open_rgb/render/color_kernels.hpp"
+
+void RainbowWave::prepare(const DeviceList& devices, const GeometryIndex& geometry) {
+	// Base hue of every LED as an index of the hue table, so frames only add the shift. The wave
+	// spans the whole canvas so it flows from one device to the next
+	_hues.clear();
+	for (size_t d = 0; d < devices.size(); d++) {
+		auto positions = geometry.canvasX(d);
+		std::vector<int32_t> hues(positions.size(), -1);
+		for (size_t i = 0; i < positions.size(); ++i) {
+			if (positions[i] >= 0) {
+				hues[i] = static_cast<int32_t>(ColorKernels::hueIndex(360.0 * (1 - positions[i])));
 			}
 		}
+		_hues.emplace_back(std::move(hues));
 	}
+}
 
-	// Crear el array rainbow
-	std::vector<int> rainbow(3 * longest_zone);
-	int inc = 360.0 / rainbow.size();
-	for (int idx = rainbow.size() - 1; idx >= 0; --idx) {
-		rainbow[idx] = (rainbow.size() - idx) * inc;
-	}
-
-	// Loop principal
-	while (_is_running) {
-		for (auto& dev : devices) {
-			if (dev.enabled) {
-				std::vector<Color> colors(dev.leds.size(), Color(0, 0, 0));
-				size_t offset = 0;
-
-				for (auto& zone : dev.zones) {
-					if (zone.type == orgb::ZoneType::Matrix) {
-						for (size_t r = 0; r < zone.matrix_height; ++r) {
-							for (size_t c = 0; c < zone.matrix_width; ++c) {
-								if (zone.matrix_values[(r * zone.matrix_width) + c] < colors.size()) {
-									size_t rainbow_index = std::round(rainbow.size() * (c / static_cast<double>(zone.matrix_width)));
-									colors[offset + zone.matrix_values[(r * zone.matrix_width) + c]] = Color::fromHsv(rainbow[rainbow_index], 1, 1);
-								}
-							}
-						}
-					} else {
-						for (size_t l = 0; l < zone.leds_count; ++l) {
-							size_t rainbow_index = std::floor(rainbow.size() * (l / static_cast<double>(zone.leds_count)));
-							colors[offset + l]	 = Color::fromHsv(rainbow[rainbow_index], 1, 1);
-						}
-					}
-					offset += zone.leds_count;
-				}
+void RainbowWave::render(const FrameTime& time, const Device&, size_t devIdx, std::span<Color> leds) {
+	const auto& hues = _hues[devIdx];
+	auto shift		 = ColorKernels::hueIndex(time.elapsed * _speed);
 
-				_set_colors(dev, colors);
-			}
+	for (size_t i = 0; i < leds.size(); ++i) {
+		if (hues[i] >= 0) {
+			leds[i] = ColorKernels::hueAt(hues[i] + shift);
 		}
-
-		_sleep(4.0 / rainbow.size());
-
-		// Rotación del rainbow
-		rainbow.insert(rainbow.begin(), std::fmod(rainbow[0] + inc, 360.0));
-		rainbow.pop_back();
 	}
 }
 
-RainbowWave::RainbowWave(Client& client) : AbstractEffect(client, "Rainbow wave") {
+RainbowWave::RainbowWave() : AbstractEffect("Rainbow wave") {
+	_min_fps = 20;
+	_max_fps = 60;
 }
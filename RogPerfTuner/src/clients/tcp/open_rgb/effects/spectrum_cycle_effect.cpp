@@ -1,19 +1,19 @@
 #include "clients/tcp/open_rgb/effects/spectrum_cycle_effect.hpp"
 
-void SpectrumCycleEffect::apply_effect(const DeviceList& devices) {
-	int offset = 0;
-	while (_is_running) {
-		for (auto& dev : devices) {
-			if (dev.enabled) {
-				std::vector<Color> colors(dev.leds.size(), Color::fromHsv(offset, 1, 1));
-				_set_colors(dev, colors);
-			}
-		}
+#include <algorithm>
+#include <cmath>
 
-		offset = (offset + 1) % 360;
-		_sleep(0.02);
-	}
+#include "clients/tcp/open_rgb/render/color_kernels.hpp"
+
+void SpectrumCycleEffect::tick(const FrameTime& time) {
+	_current = ColorKernels::hue(std::fmod(time.elapsed / _cycle_time, 1.0) * 360);
+}
+
+void SpectrumCycleEffect::render(const FrameTime&, const Device&, size_t, std::span<Color> leds) {
+	std::fill(leds.begin(), leds.end(), _current);
 }
 
-SpectrumCycleEffect::SpectrumCycleEffect(Client& client) : AbstractEffect(client, "Spectrum cycle") {
-}
\ No newline at end of file
+SpectrumCycleEffect::SpectrumCycleEffect() : AbstractEffect("Spectrum cycle") {
+	_min_fps = 10;
+	_max_fps = 30;
+}
@@ -2,59 +2,68 @@
 
 #include <random>
 
+#include "clients/tcp/open_rgb/render/color_kernels.hpp"
+
 Color StarryNightEffect::_get_random() {
 	std::uniform_int_distribution<int> hue_dist(0, 359);
 	int hue = hue_dist(_rng);
-	return Color::fromHsv(hue, 1, 1);
+	return ColorKernels::hue(hue);
 }
 
-void StarryNightEffect::_device_effect(Device& device) {
-	std::vector<Color> leds(device.leds.size(), Color::fromRgb("#000000"));
-	std::vector<int> steps(device.leds.size(), 0);
+void StarryNightEffect::_step(DeviceState& state) {
+	std::uniform_int_distribution<int> led_dist(0, state.leds.size() - 1);
 
-	std::uniform_real_distribution<double> sleep_dist(0, 0.15);
-	std::uniform_int_distribution<int> led_dist(0, device.leds.size() - 1);
-
-	while (device.enabled && _is_running) {
-		std::vector<Color> new_colors(device.leds.size());
-		int active_count = 0;
-
-		for (size_t i = 0; i < leds.size(); ++i) {
-			steps[i]	  = std::max(0, steps[i] - 1);
-			new_colors[i] = leds[i] * (static_cast<double>(steps[i]) / _max_steps);
-			if (steps[i] > 0) {
-				active_count++;
-			}
+	int active_count = 0;
+	for (size_t i = 0; i < state.leds.size(); ++i) {
+		state.steps[i] = std::max(0, state.steps[i] - 1);
+		if (state.steps[i] > 0) {
+			active_count++;
 		}
+	}
 
-		double active_ratio = static_cast<double>(active_count) / leds.size();
-		if (active_ratio < 0.2) {
-			int led_on = -1;
-			while (led_on < 0 || steps[led_on] > 0) {
-				led_on = led_dist(_rng);
-			}
-			steps[led_on]	   = 20 + (rand() % 11);
-			Color random_color = _get_random() * (static_cast<double>(steps[led_on]) / _max_steps);
-			leds[led_on] = new_colors[led_on] = random_color;
+	double active_ratio = static_cast<double>(active_count) / state.leds.size();
+	if (active_ratio < 0.2) {
+		int led_on = -1;
+		while (led_on < 0 || state.steps[led_on] > 0) {
+			led_on = led_dist(_rng);
 		}
-
-		_set_colors(device, new_colors);
-		_sleep(sleep_dist(_rng));
+		state.steps[led_on] = std::uniform_int_distribution<int>(20, 30)(_rng);
+		state.leds[led_on]	= ColorKernels::scale(_get_random(), static_cast<double>(state.steps[led_on]) / _max_steps);
 	}
 }
-StarryNightEffect::StarryNightEffect(Client& client) : AbstractEffect(client, "Starry night") {
+
+StarryNightEffect::StarryNightEffect() : AbstractEffect("Starry night") {
+	_min_fps = 10;
+	_max_fps = 30;
 }
 
-void StarryNightEffect::apply_effect(const DeviceList& devices) {
-	_threads.clear();
+void StarryNightEffect::prepare(const DeviceList& devices, const GeometryIndex&) {
+	_states.clear();
 	for (auto& device : devices) {
-		_threads.emplace_back([this, &device] {
-			_device_effect(device);
-		});
+		_states.emplace_back(DeviceState{std::vector<Color>(device.leds.size(), Color::Black), std::vector<int>(device.leds.size(), 0), 0});
 	}
-	for (auto& t : _threads) {
-		if (t.joinable()) {
-			t.join();
-		}
+}
+
+void StarryNightEffect::remap(const DeviceList& devices, const GeometryIndex&, const std::vector<std::optional<size_t>>& previous) {
+	_states = carryOver(_states, previous, [&devices](size_t d) {
+		return DeviceState{std::vector<Color>(devices[d].leds.size(), Color::Black), std::vector<int>(devices[d].leds.size(), 0), 0};
+	});
+}
+
+void StarryNightEffect::render(const FrameTime& time, const Device&, size_t devIdx, std::span<Color> leds) {
+	auto& state = _states[devIdx];
+	if (state.leds.empty()) {
+		return;
+	}
+
+	std::uniform_real_distribution<double> sleep_dist(0, 0.15);
+	state.until_next -= time.delta;
+	while (state.until_next <= 0) {
+		_step(state);
+		state.until_next += sleep_dist(_rng);
+	}
+
+	for (size_t i = 0; i < leds.size(); ++i) {
+		leds[i] = ColorKernels::scale(state.leds[i], static_cast<double>(state.steps[i]) / _max_steps);
 	}
-}
\ No newline at end of file
+}
@@ -1,14 +1,16 @@
 #include "clients/tcp/open_rgb/effects/static_effect.hpp"
 
-void StaticEffect::apply_effect(const DeviceList& devices) {
-	for (auto& dev : devices) {
-		std::vector<Color> colors(dev.leds.size(), *_color);
-		_set_colors(dev, colors);
-	}
-	while (_is_running) {
-		_sleep(1.0);
-	}
+#include <algorithm>
+
+void StaticEffect::render(const FrameTime&, const Device&, size_t, std::span<Color> leds) {
+	std::fill(leds.begin(), leds.end(), _color.load());
+}
+
+std::optional<Color> StaticEffect::getSolidColor() {
+	return _color.load();
 }
 
-StaticEffect::StaticEffect(Client& client) : AbstractEffect(client, "Static", Color::Red.toHex()) {
-}
\ No newline at end of file
+StaticEffect::StaticEffect() : AbstractEffect("Static", Color::Red.toHex()) {
+	_min_fps = 1;
+	_max_fps = 1;
+}
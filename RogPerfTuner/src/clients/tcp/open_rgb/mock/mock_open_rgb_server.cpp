@@ -0,0 +1,336 @@
+#include "clients/tcp/open_rgb/mock/mock_open_rgb_server.hpp"
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "framework/utils/string_utils.hpp"
+
+namespace {
+void appendU16(std::string& out, uint16_t value) {
+	out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void appendU32(std::string& out, uint32_t value) {
+	out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void appendString(std::string& out, const std::string& value) {
+	appendU16(out, value.size() + 1);
+	out.append(value);
+	out.push_back('\0');
+}
+
+bool readFull(int fd, char* buffer, size_t size) {
+	size_t done = 0;
+	while (done < size) {
+		auto bytes = recv(fd, buffer + done, size - done, 0);
+		if (bytes <= 0) {
+			return false;
+		}
+		done += bytes;
+	}
+	return true;
+}
+
+template <typename T>
+T readLe(const char* data) {
+	T value{};
+	std::memcpy(&value, data, sizeof(T));
+	return value;
+}
+}  // namespace
+
+std::vector<MockOpenRgbServer::DeviceSpec> MockOpenRgbServer::parseSpecs(const std::string& spec) {
+	std::vector<DeviceSpec> result;
+	for (auto& item : StringUtils::split(spec, ',')) {
+		auto parts = StringUtils::split(StringUtils::trim(item), ':');
+		if (parts.size() != 2) {
+			throw std::invalid_argument("Invalid device spec '" + item + "'");
+		}
+
+		DeviceSpec dev;
+		auto type = StringUtils::toLowerCase(parts[0]);
+		if (type == "keyboard") {
+			dev.type = orgb::DeviceType::Keyboard;
+		} else if (type == "mouse") {
+			dev.type = orgb::DeviceType::Mouse;
+		} else if (type == "strip") {
+			dev.type = orgb::DeviceType::LEDStrip;
+		}
+		dev.name = "Mock " + type + " " + std::to_string(result.size());
+
+		auto size = StringUtils::split(parts[1], 'x');
+		if (size.size() == 2) {
+			dev.rows	= std::stoul(size[0]);
+			dev.columns = std::stoul(size[1]);
+		} else {
+			dev.columns = std::stoul(size[0]);
+		}
+		result.push_back(dev);
+	}
+	return result;
+}
+
+MockOpenRgbServer::MockOpenRgbServer(const std::vector<DeviceSpec>& specs) : Loggable("MockOpenRgbServer"), _specs(specs) {
+	for (auto& spec : _specs) {
+		_colors.emplace_back(std::max<uint32_t>(spec.rows, 1) * spec.columns, orgb::Color::Black);
+	}
+}
+
+MockOpenRgbServer::~MockOpenRgbServer() {
+	stop();
+}
+
+int MockOpenRgbServer::start() {
+	_listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (_listenFd < 0) {
+		throw std::runtime_error("Couldn't create socket");
+	}
+
+	sockaddr_in addr{};
+	addr.sin_family		 = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port		 = 0;
+
+	socklen_t addrlen = sizeof(addr);
+	if (bind(_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(_listenFd, 4) < 0 ||
+		getsockname(_listenFd, reinterpret_cast<sockaddr*>(&addr), &addrlen) < 0) {
+		close(_listenFd);
+		_listenFd = -1;
+		throw std::runtime_error("Couldn't listen on localhost");
+	}
+
+	int port = ntohs(addr.sin_port);
+	logger->info("Listening on port {} with {} devices", port, _specs.size());
+	_running	  = true;
+	_acceptThread = std::thread(&MockOpenRgbServer::acceptLoop, this);
+	return port;
+}
+
+void MockOpenRgbServer::stop() {
+	if (!_running) {
+		return;
+	}
+
+	_running = false;
+	if (_acceptThread.joinable()) {
+		_acceptThread.join();
+	}
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (auto fd : _clientFds) {
+			shutdown(fd, SHUT_RDWR);
+		}
+	}
+	for (auto& thread : _clientThreads) {
+		thread.join();
+	}
+	_clientThreads.clear();
+	for (auto fd : _clientFds) {
+		close(fd);
+	}
+	_clientFds.clear();
+	close(_listenFd);
+	_listenFd = -1;
+}
+
+MockOpenRgbServer::Stats MockOpenRgbServer::getStats() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _stats;
+}
+
+void MockOpenRgbServer::resetStats() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_stats = Stats{};
+}
+
+std::vector<orgb::Color> MockOpenRgbServer::getColors(size_t devIdx) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _colors.at(devIdx);
+}
+
+void MockOpenRgbServer::acceptLoop() {
+	pollfd pfd{_listenFd, POLLIN, 0};
+	while (_running) {
+		if (poll(&pfd, 1, 100) <= 0) {
+			continue;
+		}
+
+		int fd = accept4(_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+		if (fd >= 0) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			_clientFds.push_back(fd);
+			_clientThreads.emplace_back(&MockOpenRgbServer::clientLoop, this, fd);
+		}
+	}
+}
+
+void MockOpenRgbServer::clientLoop(int fd) {
+	uint32_t version = 0;
+	char header[16];
+	std::vector<char> body;
+
+	while (_running && readFull(fd, header, sizeof(header))) {
+		if (std::memcmp(header, "ORGB", 4) != 0) {
+			logger->error("Error while reading packet: bad magic");
+			break;
+		}
+
+		auto devIdx	  = readLe<uint32_t>(header + 4);
+		auto packetId = readLe<uint32_t>(header + 8);
+		auto size	  = readLe<uint32_t>(header + 12);
+		body.resize(size);
+		if (size > 0 && !readFull(fd, body.data(), size)) {
+			break;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stats.packets++;
+			_stats.bytes += sizeof(header) + size;
+		}
+
+		std::string out;
+		switch (packetId) {
+			case REQUEST_PROTOCOL_VERSION:
+				version = std::min(size >= 4 ? readLe<uint32_t>(body.data()) : 0, PROTOCOL_VERSION);
+				appendU32(out, PROTOCOL_VERSION);
+				reply(fd, 0, packetId, out);
+				break;
+			case REQUEST_CONTROLLER_COUNT:
+				appendU32(out, _specs.size());
+				reply(fd, 0, packetId, out);
+				break;
+			case REQUEST_CONTROLLER_DATA:
+				if (devIdx < _specs.size()) {
+					auto data = controllerData(devIdx, version);
+					appendU32(out, data.size() + sizeof(uint32_t));
+					reply(fd, devIdx, packetId, out + data);
+				}
+				break;
+			case REQUEST_RESCAN_DEVICES: {
+				std::lock_guard<std::mutex> lock(_mutex);
+				for (auto client : _clientFds) {
+					reply(client, 0, DEVICE_LIST_UPDATED, "");
+				}
+				break;
+			}
+			case UPDATE_LEDS:
+				// data size, color count, colors
+				if (devIdx < _specs.size() && size >= 6) {
+					storeColors(devIdx, 0, body.data() + 6, std::min<size_t>(readLe<uint16_t>(body.data() + 4), (size - 6) / 4));
+					std::lock_guard<std::mutex> lock(_mutex);
+					_stats.fullPackets++;
+				}
+				break;
+			case UPDATE_ZONE_LEDS:
+				// data size, zone, color count, colors; every mock device has a single zone
+				if (devIdx < _specs.size() && size >= 10) {
+					storeColors(devIdx, 0, body.data() + 10, std::min<size_t>(readLe<uint16_t>(body.data() + 8), (size - 10) / 4));
+					std::lock_guard<std::mutex> lock(_mutex);
+					_stats.zonePackets++;
+				}
+				break;
+			case UPDATE_SINGLE_LED:
+				if (devIdx < _specs.size() && size >= 8) {
+					storeColors(devIdx, readLe<uint32_t>(body.data()), body.data() + 4, 1);
+					std::lock_guard<std::mutex> lock(_mutex);
+					_stats.ledPackets++;
+				}
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+bool MockOpenRgbServer::reply(int fd, uint32_t devIdx, uint32_t packetId, const std::string& body) {
+	std::string packet = "ORGB";
+	appendU32(packet, devIdx);
+	appendU32(packet, packetId);
+	appendU32(packet, body.size());
+	packet += body;
+	return send(fd, packet.data(), packet.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(packet.size());
+}
+
+std::string MockOpenRgbServer::controllerData(size_t devIdx, uint32_t version) {
+	auto& spec	= _specs[devIdx];
+	bool matrix = spec.rows > 0;
+	auto leds	= std::max<uint32_t>(spec.rows, 1) * spec.columns;
+
+	std::string out;
+	appendU32(out, static_cast<uint32_t>(spec.type));
+	appendString(out, spec.name);
+	if (version >= 1) {
+		appendString(out, "RogPerfTuner");
+	}
+	appendString(out, "Synthetic device");
+	appendString(out, "1.0");
+	appendString(out, "MOCK" + std::to_string(devIdx));
+	appendString(out, "Mock: " + std::to_string(devIdx));
+
+	// A single Direct mode with per LED colors
+	appendU16(out, 1);
+	appendU32(out, 0);
+	appendString(out, "Direct");
+	appendU32(out, 0);
+	appendU32(out, 1 << 5);
+	appendU32(out, 0);
+	appendU32(out, 0);
+	if (version >= 3) {
+		appendU32(out, 0);
+		appendU32(out, 0);
+	}
+	appendU32(out, 0);
+	appendU32(out, 0);
+	appendU32(out, 0);
+	if (version >= 3) {
+		appendU32(out, 0);
+	}
+	appendU32(out, 0);
+	appendU32(out, 1);
+	appendU16(out, 0);
+
+	appendU16(out, 1);
+	appendString(out, matrix ? "Keys" : "LEDs");
+	appendU32(out, static_cast<uint32_t>(matrix ? orgb::ZoneType::Matrix : orgb::ZoneType::Linear));
+	appendU32(out, leds);
+	appendU32(out, leds);
+	appendU32(out, leds);
+	if (matrix) {
+		appendU16(out, (leds + 2) * sizeof(uint32_t));
+		appendU32(out, spec.rows);
+		appendU32(out, spec.columns);
+		for (uint32_t i = 0; i < leds; i++) {
+			appendU32(out, i);
+		}
+	} else {
+		appendU16(out, 0);
+	}
+
+	appendU16(out, leds);
+	for (uint32_t i = 0; i < leds; i++) {
+		appendString(out, (matrix ? "Key: " : "LED ") + std::to_string(i));
+		appendU32(out, i);
+	}
+
+	appendU16(out, leds);
+	for (uint32_t i = 0; i < leds; i++) {
+		appendU32(out, 0);
+	}
+	return out;
+}
+
+void MockOpenRgbServer::storeColors(size_t devIdx, size_t offset, const char* data, size_t count) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto& colors = _colors[devIdx];
+	for (size_t i = 0; i < count && offset + i < colors.size(); i++) {
+		std::memcpy(&colors[offset + i], data + (i * 4), 4);
+	}
+}
@@ -1,9 +1,19 @@
 #include "clients/tcp/open_rgb/open_rgb_client.hpp"
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "clients/shell/asusctl_client.hpp"
+#include "clients/tcp/open_rgb/effects/audio_spectrum_effect.hpp"
 #include "clients/tcp/open_rgb/effects/breathing_effect.hpp"
 #include "clients/tcp/open_rgb/effects/dance_floor_effect.hpp"
 #include "clients/tcp/open_rgb/effects/digital_rain_effect.hpp"
@@ -13,6 +23,7 @@
 #include "clients/tcp/open_rgb/effects/spectrum_cycle_effect.hpp"
 #include "clients/tcp/open_rgb/effects/starry_night_effect.hpp"
 #include "clients/tcp/open_rgb/effects/static_effect.hpp"
+#include "framework/utils/enum_utils.hpp"
 #include "framework/utils/file_utils.hpp"
 #include "framework/utils/net_utils.hpp"
 #include "framework/utils/process_utils.hpp"
@@ -47,22 +58,55 @@ void OpenRgbClient::initialize() {
 	Logger::rem_tab();
 	logger->debug("Found {} compatible devices", compatibleDevices.size());
 
-	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&BreathingEffect::init(client)));
-	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&DanceFloorEffect::init(client)));
-	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&DigitalRainEffect::init(client)));
-	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&DropsEffect::init(client)));
-	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&GamingEffect::init(client)));
-	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&RainbowWave::init(client)));
-	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&SpectrumCycleEffect::init(client)));
-	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&StarryNightEffect::init(client)));
-	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&StaticEffect::init(client)));
+	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&AudioSpectrumEffect::init()));
+	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&BreathingEffect::init()));
+	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&DanceFloorEffect::init()));
+	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&DigitalRainEffect::init()));
+	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&DropsEffect::init()));
+	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&GamingEffect::init()));
+	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&RainbowWave::init()));
+	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&SpectrumCycleEffect::init()));
+	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&StarryNightEffect::init()));
+	availableEffects.push_back(std::unique_ptr<AbstractEffect>(&StaticEffect::init()));
 	currentEffectIdx = availableEffects.size() - 1;
 
 	eventBus.onApplicationShutdown([this]() {
 		stop();
 	});
 
-	start();
+	loadDeviceSnapshot();
+	if (!canUseAura()) {
+		startAsync();
+	} else {
+		logger->info("Only the built-in keyboard was found, OpenRGB will be started when needed");
+	}
+}
+
+void OpenRgbClient::startAsync() {
+	started = true;
+	// A previous attempt that failed has already finished, but its thread is still joinable
+	if (starter.joinable()) {
+		starter.join();
+	}
+
+	// Detection can take seconds, the effect is applied once it finishes and the rest of the app starts meanwhile
+	starter = std::thread([this]() {
+		try {
+			start();
+		} catch (std::exception& e) {
+			logger->error("Error while starting OpenRGB: {}", e.what());
+		}
+	});
+}
+
+bool OpenRgbClient::canUseAura() {
+	return !started && builtInOnly && asusCtlClient.available();
+}
+
+void OpenRgbClient::applyAura(AbstractEffect& effect, const RgbBrightness& brightness) {
+	auto color = brightness == RgbBrightness::OFF ? Color::Black : *effect.getSolidColor() * (toInt(brightness) / 100.0);
+	logger->info("Applying {} through Aura with color {}", effect.getName(), StringUtils::toUpperCase(color.toHex()));
+	asusCtlClient.setAuraColor(color.toHex());
 }
 
 void OpenRgbClient::configureUdev() {
@@ -75,18 +119,72 @@ void OpenRgbClient::start() {
 	if (asusCtlClient.available()) {
 		asusCtlClient.turnOffAura();
 	}
-	startOpenRgbProcess();
-	startOpenRgbClient();
-	getAvailableDevices();
+	started = true;
+	try {
+		startOpenRgbProcess();
+		startOpenRgbClient();
+		getAvailableDevices();
+	} catch (std::exception& e) {
+		abortStart();
+		Logger::rem_tab();
+		throw;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	ready = true;
+	if (pendingBrightness.has_value()) {
+		renderEngine.start(*availableEffects.at(currentEffectIdx), detectedDevices, geometry, *pendingBrightness);
+		pendingBrightness = std::nullopt;
+	}
+	Logger::rem_tab();
+}
+
+void OpenRgbClient::abortStart() {
+	logger->info("Cleaning up failed start");
+	Logger::add_tab();
+	try {
+		client.disconnect();
+	} catch (std::exception& e) {
+	}
+	stopOpenRgbProcess();
+
+	// Left as never started, so the next device found or effect applied retries it
+	std::lock_guard<std::mutex> lock(mutex);
+	started			  = false;
+	ready			  = false;
+	pendingBrightness = std::nullopt;
+
+	auto& effect = *availableEffects.at(currentEffectIdx);
+	if (asusCtlClient.available() && (currentBrightness == RgbBrightness::OFF || effect.getSolidColor().has_value())) {
+		applyAura(effect, currentBrightness);
+	} else {
+		logger->warn("{} can't be applied through Aura, lighting stays off", effect.getName());
+	}
 	Logger::rem_tab();
 }
 
 void OpenRgbClient::stop() {
+	if (starter.joinable() && starter.get_id() != std::this_thread::get_id()) {
+		starter.join();
+	}
+
+	// A rescan in progress is using the connection without holding the lock
+	std::unique_lock<std::mutex> lock(mutex);
+	rescanDone.wait(lock, [this]() {
+		return !rescanning;
+	});
+	if (!started) {
+		if (builtInOnly && asusCtlClient.available()) {
+			asusCtlClient.turnOffAura();
+		}
+		return;
+	}
+
 	logger->info("Stopping OpenRgbClient");
 	Logger::add_tab();
-	for (auto& effect : availableEffects) {
-		effect->stop();
-	}
+	started = false;
+	ready	= false;
+	renderEngine.stop();
 	for (auto& dev : detectedDevices) {
 		client.setDeviceColor(dev, Color::Black);
 	}
@@ -108,17 +206,17 @@ void OpenRgbClient::startOpenRgbProcess() {
 	Logger::add_tab();
 	port		 = NetUtils::getRandomFreePort();
 	runnerThread = std::thread(&OpenRgbClient::runner, this);
-	while (NetUtils::isPortFree(port)) {
-		TimeUtils::sleep(50);
-	}
-	logger->info("OpenRgb server ready");
 	Logger::rem_tab();
 }
 
 void OpenRgbClient::stopOpenRgbProcess() {
 	logger->info("Stopping OpenRGB server");
 	Logger::add_tab();
-	ProcessUtils::sendSignal(pid, SIGKILL);
+	// The runner sets the pid once launched, a start that failed earlier has nothing to kill
+	if (pid > 0) {
+		ProcessUtils::sendSignal(pid, SIGKILL);
+		pid = 0;
+	}
 	if (runnerThread.joinable()) {
 		runnerThread.join();
 	}
@@ -153,7 +251,19 @@ void OpenRgbClient::runner() {
 void OpenRgbClient::startOpenRgbClient() {
 	logger->info("Connecting to server");
 	Logger::add_tab();
-	client.connect("localhost", port);
+
+	// The server is ready as soon as it accepts connections, retried with backoff while it starts
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CONNECT_TIMEOUT_MS);
+	int delay	  = CONNECT_RETRY_MS;
+	while (client.connect("localhost", port) != orgb::ConnectStatus::Success) {
+		if (std::chrono::steady_clock::now() >= deadline) {
+			Logger::rem_tab();
+			throw std::runtime_error("OpenRGB server not reachable on port " + std::to_string(port));
+		}
+		TimeUtils::sleep(delay);
+		delay = std::min(delay * 2, CONNECT_MAX_RETRY_MS);
+	}
+
 	logger->info("Connected");
 	Logger::rem_tab();
 }
@@ -163,16 +273,205 @@ void OpenRgbClient::getAvailableDevices() {
 	Logger::add_tab();
 
 	detectedDevices = client.requestDeviceList().devices;
+
+	// The server answers while detection is still running, the last known devices tell if it has finished
+	std::unordered_set<std::string> found;
+	for (auto& dev : detectedDevices) {
+		found.insert(deviceKey(dev));
+	}
+	auto missing = std::count_if(deviceSnapshot.begin(), deviceSnapshot.end(), [&found](const std::string& key) {
+		return !found.contains(key);
+	});
+	if (missing > 0) {
+		logger->info("Waiting for {} known devices", missing);
+		if (waitForDeviceUpdate()) {
+			detectedDevices = client.requestDeviceList().devices;
+		}
+	}
+
+	for (auto& dev : detectedDevices) {
+		setupDevice(dev);
+	}
+	geometry.build(detectedDevices);
+	saveDeviceSnapshot();
+
+	Logger::rem_tab();
+}
+
+std::string OpenRgbClient::deviceKey(const orgb::Device& dev) {
+	return dev.name + "@" + dev.location;
+}
+
+void OpenRgbClient::loadDeviceSnapshot() {
+	deviceSnapshot.clear();
+	std::vector<int> types;
+	if (FileUtils::exists(Constants::ORGB_DEVICES_FILE)) {
+		// One device per line, its type and its key separated by a tab
+		for (auto& line : StringUtils::splitLines(FileUtils::readFileContent(Constants::ORGB_DEVICES_FILE))) {
+			auto pos = line.find('\t');
+			if (pos != std::string::npos) {
+				types.push_back(std::atoi(line.substr(0, pos).c_str()));
+				deviceSnapshot.push_back(line.substr(pos + 1));
+			}
+		}
+	}
+
+	builtInOnly = types.size() == 1 && (types[0] == static_cast<int>(orgb::DeviceType::Keyboard) ||
+										types[0] == static_cast<int>(orgb::DeviceType::Laptop));
+	logger->debug("Last run found {} devices", deviceSnapshot.size());
+}
+
+void OpenRgbClient::saveDeviceSnapshot() {
+	deviceSnapshot.clear();
+	std::string content;
 	for (auto& dev : detectedDevices) {
-		const orgb::Mode* directMode = dev.findMode("Direct");
-		if (directMode) {
-			logger->info(dev.name);
-			client.changeMode(dev, *directMode);
-			client.setDeviceColor(dev, orgb::Color::Black);
+		deviceSnapshot.push_back(deviceKey(dev));
+		content += std::to_string(static_cast<int>(dev.type)) + "\t" + deviceSnapshot.back() + "\n";
+	}
+
+	try {
+		FileUtils::writeFileContent(Constants::ORGB_DEVICES_FILE, content);
+	} catch (std::exception& e) {
+		logger->warn("Error while saving device list: {}", e.what());
+	}
+}
+
+void OpenRgbClient::setupDevice(const orgb::Device& dev) {
+	const orgb::Mode* directMode = dev.findMode("Direct");
+	if (directMode) {
+		logger->info(dev.name);
+		client.changeMode(dev, *directMode);
+		client.setDeviceColor(dev, orgb::Color::Black);
+	}
+}
+
+bool OpenRgbClient::rescanDevices() {
+	std::unique_lock<std::mutex> lock(mutex);
+	if (!started) {
+		logger->info("New device found, starting OpenRGB");
+		startAsync();
+		pendingBrightness = currentBrightness;
+		return true;
+	}
+	if (!ready) {
+		logger->info("Detection still running, rescan not needed");
+		return true;
+	}
+
+	logger->info("Rescanning devices");
+	Logger::add_tab();
+
+	// The connection is shared with the render thread, so it is paused while the server is asked for the new list.
+	// The lock is released for the wait, effects applied meanwhile are kept as pending like during startup
+	renderEngine.pause();
+	ready	   = false;
+	rescanning = true;
+	lock.unlock();
+
+	std::optional<orgb::DeviceListResult> result;
+	if (requestRescan() && waitForDeviceUpdate()) {
+		result = client.requestDeviceList();
+		if (result->status != orgb::RequestStatus::Success) {
+			logger->error("Error while requesting device list: {}", orgb::enumString(result->status));
+			result = std::nullopt;
 		}
 	}
 
+	lock.lock();
+	bool updated = result.has_value();
+	if (updated) {
+		std::unordered_map<std::string, bool> known;
+		for (auto& dev : detectedDevices) {
+			known[deviceKey(dev)] = dev.enabled;
+		}
+
+		logger->info("Attaching new devices");
+		Logger::add_tab();
+		for (auto& dev : result->devices.devices()) {
+			auto it = known.find(deviceKey(*dev));
+			if (it == known.end()) {
+				setupDevice(*dev);
+			} else {
+				dev->enabled = it->second;
+				known.erase(it);
+			}
+		}
+		Logger::rem_tab();
+		for (auto& [name, enabled] : known) {
+			logger->info("Detached {}", name);
+		}
+
+		detectedDevices = std::move(result->devices);
+		geometry.build(detectedDevices);
+		saveDeviceSnapshot();
+	}
+
+	ready	   = true;
+	rescanning = false;
+	if (pendingBrightness.has_value()) {
+		renderEngine.start(*availableEffects.at(currentEffectIdx), detectedDevices, geometry, *pendingBrightness);
+		pendingBrightness = std::nullopt;
+	} else {
+		renderEngine.resume(detectedDevices, geometry);
+	}
+	rescanDone.notify_all();
 	Logger::rem_tab();
+	return updated;
+}
+
+bool OpenRgbClient::requestRescan() {
+	int sock = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (sock < 0) {
+		logger->error("Error while requesting rescan: {}", std::strerror(errno));
+		return false;
+	}
+
+	sockaddr_in addr{};
+	addr.sin_family		 = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port		 = htons(port);
+
+	// Bare protocol header, the SDK has no rescan request and its socket is not exposed
+	char packet[16]	   = {'O', 'R', 'G', 'B'};
+	uint32_t fields[3] = {0, RESCAN_PACKET_ID, 0};
+	std::memcpy(packet + 4, fields, sizeof(fields));
+
+	bool sent = connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+				send(sock, packet, sizeof(packet), MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(packet));
+	if (!sent) {
+		logger->error("Error while requesting rescan: {}", std::strerror(errno));
+	}
+	close(sock);
+	return sent;
+}
+
+bool OpenRgbClient::waitForDeviceUpdate() {
+	auto deadline	= std::chrono::steady_clock::now() + std::chrono::milliseconds(RESCAN_TIMEOUT_MS);
+	auto lastUpdate = std::chrono::steady_clock::time_point{};
+	bool updated	= false;
+
+	// Detection reports every controller it finds, so the list is only read once the updates settle
+	while (std::chrono::steady_clock::now() < deadline) {
+		auto status = client.checkForDeviceUpdates();
+		if (status == orgb::UpdateStatus::OutOfDate) {
+			updated	   = true;
+			lastUpdate = std::chrono::steady_clock::now();
+			continue;
+		}
+		if (status != orgb::UpdateStatus::UpToDate) {
+			logger->error("Error while waiting for device update: {}", orgb::enumString(status));
+			return false;
+		}
+		if (updated && std::chrono::steady_clock::now() - lastUpdate >= std::chrono::milliseconds(RESCAN_SETTLE_MS)) {
+			return true;
+		}
+		TimeUtils::sleep(RESCAN_POLL_MS);
+	}
+
+	if (!updated) {
+		logger->warn("Server didn't report a device update in {} ms", RESCAN_TIMEOUT_MS);
+	}
+	return updated;
 }
 
 const std::vector<std::string> OpenRgbClient::getAvailableEffects() {
@@ -184,17 +483,34 @@ const std::vector<std::string> OpenRgbClient::getAvailableEffects() {
 }
 
 void OpenRgbClient::applyEffect(const std::string& effectName, const RgbBrightness& brightness, const std::optional<std::string>& color) {
-	for (const auto& effect : availableEffects) {
-		effect->stop();
-	}
+	std::lock_guard<std::mutex> lock(mutex);
 	int idx = 0;
 	for (const auto& effect : availableEffects) {
 		if (effect->getName() == effectName) {
 			if (effect->supportsColor() && color.has_value()) {
 				effect->setColor(color.value());
 			}
-			effect->start(detectedDevices, brightness);
-			currentEffectIdx = idx;
+			currentEffectIdx  = idx;
+			currentBrightness = brightness;
+
+			// Solid colors on the built-in keyboard alone don't need OpenRGB, it is only started for anything else
+			if (canUseAura() && (brightness == RgbBrightness::OFF || effect->getSolidColor().has_value())) {
+				applyAura(*effect, brightness);
+				break;
+			}
+			if (!started) {
+				startAsync();
+			}
+
+			if (ready) {
+				// Color and brightness changes on the running effect are picked up by the next frame
+				if (!renderEngine.update(*effect, brightness)) {
+					renderEngine.start(*effect, detectedDevices, geometry, brightness);
+				}
+			} else {
+				logger->info("Effect {} will be applied once OpenRGB is ready", effectName);
+				pendingBrightness = brightness;
+			}
 			break;
 		}
 		idx++;
@@ -202,6 +518,7 @@ void OpenRgbClient::applyEffect(const std::string& effectName, const RgbBrightne
 }
 
 void OpenRgbClient::disableDevice(const std::string& devName) {
+	std::lock_guard<std::mutex> lock(mutex);
 	for (auto& dev : detectedDevices.devices()) {
 		if (dev->name == devName) {
 			dev->enabled = false;
@@ -216,4 +533,20 @@ bool OpenRgbClient::supportsColor() {
 
 const std::optional<std::string> OpenRgbClient::getColor() {
 	return availableEffects.at(currentEffectIdx)->getColor();
+}
+
+void OpenRgbClient::setFps(uint32_t fps) {
+	renderEngine.setFps(fps);
+}
+
+void OpenRgbClient::setCorrections(const std::map<std::string, RgbCorrection>& corrections) {
+	renderEngine.setCorrections(corrections);
+}
+
+FpsGovernor& OpenRgbClient::getFpsGovernor() {
+	return renderEngine.getGovernor();
+}
+
+RenderEngine::Stats OpenRgbClient::getRenderStats() {
+	return renderEngine.getStats();
 }
\ No newline at end of file
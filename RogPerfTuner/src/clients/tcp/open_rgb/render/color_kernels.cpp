@@ -0,0 +1,98 @@
+#include "clients/tcp/open_rgb/render/color_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+const std::vector<Color>& hueTable() {
+	static const std::vector<Color> table = [] {
+		std::vector<Color> res;
+		res.reserve(ColorKernels::HUE_STEPS);
+		for (size_t i = 0; i < ColorKernels::HUE_STEPS; i++) {
+			res.push_back(Color::fromHsv(360.0f * i / ColorKernels::HUE_STEPS, 1, 1));
+		}
+		return res;
+	}();
+	return table;
+}
+
+uint8_t scaleChannel(uint8_t value, uint16_t factor) {
+	return static_cast<uint8_t>(((value * factor) + 128) >> 8);
+}
+}  // namespace
+
+ColorCorrection ColorCorrection::build(double brightness, double gamma, Color white) {
+	ColorCorrection res;
+	res.factor = ColorKernels::toFixed(brightness);
+	res.linear = gamma == 1.0 && white.r == 255 && white.g == 255 && white.b == 255;
+
+	brightness = std::clamp(brightness, 0.0, 1.0);
+	for (size_t i = 0; i < 256; i++) {
+		auto level = std::pow(i / 255.0, gamma) * brightness;
+		res.r[i]   = static_cast<uint8_t>(std::round(level * white.r));
+		res.g[i]   = static_cast<uint8_t>(std::round(level * white.g));
+		res.b[i]   = static_cast<uint8_t>(std::round(level * white.b));
+	}
+	return res;
+}
+
+void ColorCorrection::apply(std::span<const Color> in, std::span<Color> out) const {
+	if (linear) {
+		ColorKernels::scale(in, out, factor);
+		return;
+	}
+
+	for (size_t i = 0; i < in.size(); i++) {
+		out[i].r = r[in[i].r];
+		out[i].g = g[in[i].g];
+		out[i].b = b[in[i].b];
+	}
+}
+
+size_t ColorKernels::hueIndex(double degrees) {
+	auto idx = static_cast<int64_t>(std::lround(degrees * HUE_STEPS / 360.0)) % static_cast<int64_t>(HUE_STEPS);
+	return static_cast<size_t>(idx < 0 ? idx + HUE_STEPS : idx);
+}
+
+Color ColorKernels::hueAt(size_t index) {
+	return hueTable()[index % HUE_STEPS];
+}
+
+Color ColorKernels::hue(double degrees) {
+	return hueTable()[hueIndex(degrees)];
+}
+
+Color ColorKernels::hsv(double degrees, double saturation, double value) {
+	auto base = hue(degrees);
+	auto sat  = toFixed(saturation);
+	auto val  = toFixed(value);
+
+	// Desaturating blends every channel towards full intensity before applying the value
+	auto channel = [sat, val](uint8_t c) {
+		return scaleChannel(255 - scaleChannel(255 - c, sat), val);
+	};
+	return Color(channel(base.r), channel(base.g), channel(base.b));
+}
+
+Color ColorKernels::scale(Color color, double factor) {
+	auto fixed = toFixed(factor);
+	return Color(scaleChannel(color.r, fixed), scaleChannel(color.g, fixed), scaleChannel(color.b, fixed));
+}
+
+void ColorKernels::scale(std::span<const Color> in, std::span<Color> out, uint16_t factor) {
+	if (factor >= 256) {
+		std::copy(in.begin(), in.end(), out.begin());
+		return;
+	}
+
+	for (size_t i = 0; i < in.size(); i++) {
+		out[i].r = scaleChannel(in[i].r, factor);
+		out[i].g = scaleChannel(in[i].g, factor);
+		out[i].b = scaleChannel(in[i].b, factor);
+	}
+}
+
+uint16_t ColorKernels::toFixed(double factor) {
+	return static_cast<uint16_t>(std::lround(std::clamp(factor, 0.0, 1.0) * 256));
+}
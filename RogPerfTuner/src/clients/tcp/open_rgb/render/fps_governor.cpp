@@ -0,0 +1,43 @@
+#include "clients/tcp/open_rgb/render/fps_governor.hpp"
+
+#include <algorithm>
+
+FpsGovernor::FpsGovernor(uint32_t maxFps) : Loggable("FpsGovernor"), _maxFps(std::clamp(maxFps, MIN_FPS, MAX_FPS)) {
+}
+
+void FpsGovernor::setMaxFps(uint32_t fps) {
+	_maxFps = std::clamp(fps, MIN_FPS, MAX_FPS);
+}
+
+uint32_t FpsGovernor::getMaxFps() {
+	return _maxFps;
+}
+
+void FpsGovernor::setGaming(bool gaming) {
+	if (_gaming.exchange(gaming) != gaming) {
+		logger->debug("Games running: {}", gaming);
+	}
+}
+
+void FpsGovernor::setQuiet(bool quiet) {
+	if (_quiet.exchange(quiet) != quiet) {
+		logger->debug("Quiet profile: {}", quiet);
+	}
+}
+
+void FpsGovernor::setOnBattery(bool onBattery) {
+	if (_onBattery.exchange(onBattery) != onBattery) {
+		logger->debug("On battery: {}", onBattery);
+	}
+}
+
+uint32_t FpsGovernor::target(uint32_t effectMin, uint32_t effectMax) {
+	uint32_t cap = std::min<uint32_t>(_maxFps, effectMax);
+	uint32_t fps = cap;
+	for (bool throttle : {_gaming.load(), _quiet.load(), _onBattery.load()}) {
+		if (throttle) {
+			fps /= 2;
+		}
+	}
+	return std::clamp(std::max(fps, std::min(effectMin, cap)), MIN_FPS, MAX_FPS);
+}
@@ -0,0 +1,100 @@
+#include "clients/tcp/open_rgb/render/geometry_index.hpp"
+
+#include <algorithm>
+
+void GeometryIndex::build(const orgb::DeviceList& devices) {
+	_devices.clear();
+	_x.clear();
+	_y.clear();
+	_canvasX.clear();
+	_grid.clear();
+
+	size_t totalColumns = 0;
+	for (auto& dev : devices) {
+		DeviceGeometry geometry{_x.size(), dev.leds.size(), _grid.size(), 0, 0};
+		for (auto& zone : dev.zones) {
+			bool matrix = zone.type == orgb::ZoneType::Matrix;
+			geometry.rows += matrix ? zone.matrix_height : 1;
+			geometry.columns = std::max(geometry.columns, matrix ? zone.matrix_width : zone.leds_count);
+		}
+
+		_x.resize(geometry.first + geometry.leds, -1);
+		_y.resize(geometry.first + geometry.leds, -1);
+		_grid.resize(geometry.gridStart + (static_cast<size_t>(geometry.rows) * geometry.columns), NO_LED);
+
+		auto place = [&](uint32_t led, uint32_t row, uint32_t column, uint32_t width) {
+			if (led < geometry.leds) {
+				_grid[geometry.gridStart + (row * geometry.columns) + column] = led;
+
+				_x[geometry.first + led] = column / static_cast<float>(width);
+				_y[geometry.first + led] = row / static_cast<float>(geometry.rows);
+			}
+		};
+
+		uint32_t row	= 0;
+		uint32_t offset = 0;
+		for (auto& zone : dev.zones) {
+			if (zone.type == orgb::ZoneType::Matrix) {
+				for (uint32_t r = 0; r < zone.matrix_height; ++r) {
+					for (uint32_t c = 0; c < zone.matrix_width; ++c) {
+						auto value = zone.matrix_values[(r * zone.matrix_width) + c];
+						if (value != NO_LED) {
+							place(offset + value, row + r, c, zone.matrix_width);
+						}
+					}
+				}
+				row += zone.matrix_height;
+			} else {
+				for (uint32_t l = 0; l < zone.leds_count; ++l) {
+					place(offset + l, row, l, zone.leds_count);
+				}
+				row++;
+			}
+			offset += zone.leds_count;
+		}
+
+		totalColumns += std::max<uint32_t>(geometry.columns, 1);
+		_devices.push_back(geometry);
+	}
+
+	// Devices are placed side by side, each one as wide as its number of columns
+	_canvasX.assign(_x.size(), -1);
+	size_t start = 0;
+	for (auto& geometry : _devices) {
+		auto columns = std::max<uint32_t>(geometry.columns, 1);
+		for (size_t i = geometry.first; i < geometry.first + geometry.leds; i++) {
+			if (_x[i] >= 0) {
+				_canvasX[i] = (start + (_x[i] * columns)) / static_cast<float>(totalColumns);
+			}
+		}
+		start += columns;
+	}
+}
+
+size_t GeometryIndex::size() const {
+	return _devices.size();
+}
+
+const GeometryIndex::DeviceGeometry& GeometryIndex::device(size_t devIdx) const {
+	return _devices[devIdx];
+}
+
+std::span<const float> GeometryIndex::x(size_t devIdx) const {
+	return std::span<const float>(_x).subspan(_devices[devIdx].first, _devices[devIdx].leds);
+}
+
+std::span<const float> GeometryIndex::y(size_t devIdx) const {
+	return std::span<const float>(_y).subspan(_devices[devIdx].first, _devices[devIdx].leds);
+}
+
+std::span<const float> GeometryIndex::canvasX(size_t devIdx) const {
+	return std::span<const float>(_canvasX).subspan(_devices[devIdx].first, _devices[devIdx].leds);
+}
+
+uint32_t GeometryIndex::at(size_t devIdx, uint32_t row, uint32_t column) const {
+	auto& geometry = _devices[devIdx];
+	if (row >= geometry.rows || column >= geometry.columns) {
+		return NO_LED;
+	}
+	return _grid[geometry.gridStart + (static_cast<size_t>(row) * geometry.columns) + column];
+}
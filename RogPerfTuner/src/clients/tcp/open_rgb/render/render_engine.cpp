@@ -0,0 +1,487 @@
+#include "clients/tcp/open_rgb/render/render_engine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <format>
+
+#include "framework/tracing/tracer.hpp"
+#include "framework/utils/enum_utils.hpp"
+#include "framework/utils/string_utils.hpp"
+
+namespace {
+bool sameColors(const std::vector<Color>& a, const std::vector<Color>& b) {
+	for (size_t i = 0; i < a.size(); i++) {
+		if (a[i].r != b[i].r || a[i].g != b[i].g || a[i].b != b[i].b) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool uniform(const std::vector<Color>& colors, size_t start, size_t count) {
+	for (size_t i = start + 1; i < start + count; i++) {
+		if (colors[i].r != colors[start].r || colors[i].g != colors[start].g || colors[i].b != colors[start].b) {
+			return false;
+		}
+	}
+	return true;
+}
+
+double toMillis(std::chrono::steady_clock::duration d) {
+	return std::chrono::duration<double, std::milli>(d).count();
+}
+
+double threadCpuMs() {
+	timespec ts{};
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (ts.tv_sec * 1000.0) + (ts.tv_nsec / 1e6);
+}
+}  // namespace
+
+RenderEngine::RenderEngine(Client& client) : Loggable("RenderEngine"), _client(client) {
+}
+
+RenderEngine::~RenderEngine() {
+	stop();
+}
+
+void RenderEngine::start(AbstractEffect& effect, const DeviceList& devices, const GeometryIndex& geometry, const RgbBrightness& brightness) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	stopThread();
+	_resume = false;
+	_remap.reset();
+
+	if (brightness == RgbBrightness::OFF) {
+		logger->info("Turning off RGB");
+		for (auto& dev : devices) {
+			_client.setDeviceColor(dev, Color::Black);
+		}
+		return;
+	}
+
+	auto color = effect.getColor();
+	if (!color.has_value()) {
+		logger->info("Starting effect {} with {} brightness at {} FPS", effect.getName(), StringUtils::toLowerCase(toName(brightness)),
+					 _governor.getMaxFps());
+	} else {
+		logger->info("Starting effect {} with {} brightness and color {} at {} FPS", effect.getName(),
+					 StringUtils::toLowerCase(toName(brightness)), StringUtils::toUpperCase(color.value()), _governor.getMaxFps());
+	}
+
+	_effect		= &effect;
+	_devices	= &devices;
+	_geometry	= &geometry;
+	_brightness	= toInt(brightness) / 100.0;
+
+	_slots.clear();
+	_slots.reserve(devices.size());
+	for (auto& dev : devices) {
+		_slots.emplace_back(buildSlot(dev));
+	}
+
+	{
+		std::lock_guard<std::mutex> statsLock(_statsMutex);
+		_stats = Stats{};
+	}
+
+	_startTime = Clock::now();
+	_frame	   = 0;
+	_running   = true;
+	_thread	   = std::thread(&RenderEngine::loop, this);
+}
+
+bool RenderEngine::update(AbstractEffect& effect, const RgbBrightness& brightness) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!_running || _effect != &effect || brightness == RgbBrightness::OFF) {
+		return false;
+	}
+
+	// Only the latest value is kept, so a burst of changes is applied once on the next frame
+	_pendingBrightness = toInt(brightness);
+	{
+		std::lock_guard<std::mutex> waitLock(_waitMutex);
+		_dirty = true;
+	}
+	_cv.notify_all();
+	return true;
+}
+
+void RenderEngine::pause() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_resume = _running;
+	stopThread();
+}
+
+void RenderEngine::resume(const DeviceList& devices, const GeometryIndex& geometry) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!_resume || _effect == nullptr) {
+		return;
+	}
+	_resume = false;
+
+	// Devices that were already attached keep their last frame and their effect state, so only the new ones
+	// get a full update and nothing restarts from black
+	std::vector<DeviceSlot> previous = std::move(_slots);
+	std::vector<std::optional<size_t>> indexes;
+	_slots.clear();
+	_slots.reserve(devices.size());
+	for (auto& dev : devices) {
+		auto slot = buildSlot(dev);
+		std::optional<size_t> index;
+		for (size_t i = 0; i < previous.size(); i++) {
+			auto& old = previous[i];
+			if (old.key == slot.key && old.front.size() == slot.front.size()) {
+				slot.front		= std::move(old.front);
+				slot.back		= std::move(old.back);
+				slot.lastRender = old.lastRender;
+				slot.sendCostMs = old.sendCostMs;
+				slot.divider	= old.divider;
+				slot.sent		= old.sent;
+				index			= i;
+				break;
+			}
+		}
+		indexes.push_back(index);
+		_slots.emplace_back(std::move(slot));
+	}
+	_remap = std::move(indexes);
+
+	logger->info("Resuming effect {} on {} devices", _effect->getName(), devices.size());
+	_devices  = &devices;
+	_geometry = &geometry;
+	_running  = true;
+	_thread	  = std::thread(&RenderEngine::loop, this);
+}
+
+RenderEngine::DeviceSlot RenderEngine::buildSlot(const Device& dev) {
+	DeviceSlot slot;
+	slot.device = &dev;
+	slot.key	= dev.name + "@" + dev.location;
+	slot.front.assign(dev.leds.size(), Color::Black);
+	slot.back.assign(dev.leds.size(), Color::Black);
+	slot.out.assign(dev.leds.size(), Color::Black);
+	slot.correction = buildCorrection(dev);
+	slot.changed.reserve(dev.leds.size());
+
+	// Zone updates are only used when the zones cover the LED list exactly
+	size_t start = 0;
+	for (auto& zone : dev.zones) {
+		slot.zones.push_back({&zone, start, zone.leds_count});
+		start += zone.leds_count;
+	}
+	if (start != dev.leds.size()) {
+		slot.zones.clear();
+	}
+	slot.changedPerZone.assign(slot.zones.size(), 0);
+	slot.wholeZone.assign(slot.zones.size(), false);
+	return slot;
+}
+
+void RenderEngine::stop() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_resume = false;
+	stopThread();
+}
+
+void RenderEngine::stopThread() {
+	if (_running) {
+		logger->info("Stopping effect");
+		{
+			std::lock_guard<std::mutex> lock(_waitMutex);
+			_running = false;
+		}
+		_cv.notify_all();
+	}
+	if (_thread.joinable()) {
+		_thread.join();
+		logStats(false);
+	}
+}
+
+bool RenderEngine::isRunning() {
+	return _running;
+}
+
+void RenderEngine::setFps(uint32_t fps) {
+	_governor.setMaxFps(fps);
+}
+
+uint32_t RenderEngine::getFps() {
+	return _governor.getMaxFps();
+}
+
+FpsGovernor& RenderEngine::getGovernor() {
+	return _governor;
+}
+
+void RenderEngine::setCorrections(const std::map<std::string, RgbCorrection>& corrections) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_corrections = corrections;
+}
+
+ColorCorrection RenderEngine::buildCorrection(const Device& dev) {
+	auto it = _corrections.find(dev.name);
+	if (it == _corrections.end()) {
+		return ColorCorrection::build(_brightness);
+	}
+
+	logger->info("Applying gamma {} and white point {} to {}", it->second.gamma, StringUtils::toUpperCase(it->second.white), dev.name);
+	return ColorCorrection::build(_brightness, it->second.gamma, Color::fromRgb(it->second.white));
+}
+
+RenderEngine::Stats RenderEngine::getStats() {
+	std::lock_guard<std::mutex> lock(_statsMutex);
+	return _stats;
+}
+
+void RenderEngine::loop() {
+	try {
+		if (_remap.has_value()) {
+			_effect->remap(*_devices, *_geometry, *_remap);
+			_remap.reset();
+		} else {
+			_effect->reseed();
+			_effect->prepare(*_devices, *_geometry);
+		}
+	} catch (std::exception& e) {
+		logger->error("Error while preparing effect: {}", e.what());
+		_effect->finish();
+		_running = false;
+		return;
+	}
+
+	auto runStart  = Clock::now();
+	auto nextFrame = runStart;
+	auto nextStats = runStart + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(STATS_INTERVAL));
+	auto cpuStart  = threadCpuMs();
+	uint32_t fps   = 0;
+	double wakeSq  = 0;
+	auto& tracer   = Tracer::getInstance();
+
+	while (_running) {
+		if (_dirty.exchange(false)) {
+			applyPending();
+		}
+
+		auto target = _governor.target(_effect->getMinFps(), _effect->getMaxFps());
+		if (target != fps) {
+			logger->info("Rendering at {} FPS", target);
+			fps = target;
+		}
+		double period	= 1.0 / fps;
+		auto frameStart = Clock::now();
+		auto wakeMs		= toMillis(frameStart - nextFrame);
+
+		FrameTime time{_frame, std::chrono::duration<double>(frameStart - _startTime).count(), period};
+		try {
+			_effect->tick(time);
+			renderFrame(time, frameStart, period);
+		} catch (std::exception& e) {
+			logger->error("Error while rendering effect: {}", e.what());
+			_running = false;
+			break;
+		}
+
+		auto frameEnd = Clock::now();
+		auto frameMs  = toMillis(frameEnd - frameStart);
+		tracer.complete("rgb", "frame", frameStart, frameEnd);
+		nextFrame += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(period));
+		{
+			std::lock_guard<std::mutex> lock(_statsMutex);
+			_stats.frames++;
+			_stats.avgFrameMs += (frameMs - _stats.avgFrameMs) / _stats.frames;
+			_stats.maxFrameMs = std::max(_stats.maxFrameMs, frameMs);
+			_stats.fps		  = fps;
+			_stats.cpuMs	  = threadCpuMs() - cpuStart;
+			_stats.cpuLoad	  = _stats.cpuMs / std::max(1.0, toMillis(frameEnd - runStart));
+			wakeSq += wakeMs * wakeMs;
+			_stats.jitterMs = std::sqrt(wakeSq / _stats.frames);
+			if (nextFrame < frameEnd) {
+				// Frame overran its slot, resync instead of bursting to catch up
+				_stats.lateFrames++;
+				nextFrame = frameEnd;
+			}
+		}
+
+		if (frameEnd >= nextStats) {
+			logStats(true);
+			nextStats = frameEnd + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(STATS_INTERVAL));
+		}
+
+		std::unique_lock<std::mutex> lock(_waitMutex);
+		_cv.wait_until(lock, nextFrame, [this] {
+			return !_running || _dirty;
+		});
+		_frame++;
+	}
+
+	_effect->finish();
+	logger->info("Effect finished");
+}
+
+void RenderEngine::applyPending() {
+	auto pending = _pendingBrightness.exchange(-1);
+	if (pending < 0 || pending / 100.0 == _brightness) {
+		return;
+	}
+
+	logger->info("Changing brightness to {}%", pending);
+	_brightness = pending / 100.0;
+	for (auto& slot : _slots) {
+		slot.correction = buildCorrection(*slot.device);
+		slot.sent		= false;
+	}
+}
+
+void RenderEngine::renderFrame(const FrameTime& time, Clock::time_point now, double period) {
+	for (size_t i = 0; i < _slots.size() && _running; i++) {
+		auto& slot = _slots[i];
+		if (!slot.device->enabled) {
+			continue;
+		}
+
+		// Slow devices are only refreshed every few frames so they don't delay the rest
+		if (++slot.counter < slot.divider) {
+			continue;
+		}
+		slot.counter = 0;
+
+		FrameTime devTime = time;
+		if (slot.sent) {
+			devTime.delta = std::chrono::duration<double>(now - slot.lastRender).count();
+		}
+		slot.lastRender = now;
+
+		_effect->render(devTime, *slot.device, i, slot.back);
+		send(slot, period);
+	}
+}
+
+void RenderEngine::send(DeviceSlot& slot, double period) {
+	if (slot.sent && sameColors(slot.back, slot.front)) {
+		std::lock_guard<std::mutex> lock(_statsMutex);
+		_stats.skipped++;
+		return;
+	}
+
+	slot.correction.apply(slot.back, slot.out);
+
+	auto t0 = Clock::now();
+	transmit(slot);
+	auto sendMs = toMillis(Clock::now() - t0);
+
+	std::copy(slot.back.begin(), slot.back.end(), slot.front.begin());
+	slot.sendCostMs = slot.sent ? (0.8 * slot.sendCostMs) + (0.2 * sendMs) : sendMs;
+	slot.sent		= true;
+
+	// A device may take up to half the frame budget, beyond that it gets a lower refresh rate
+	auto budgetMs = period * 500;
+	auto fps	  = static_cast<uint32_t>(std::lround(1.0 / period));
+	auto divider  = std::clamp<uint32_t>(static_cast<uint32_t>(std::ceil(slot.sendCostMs / budgetMs)), 1, fps);
+
+	std::lock_guard<std::mutex> lock(_statsMutex);
+	if (divider != slot.divider) {
+		logger->debug("{} refreshed every {} frames ({:.2f} ms per update)", slot.device->name, divider, slot.sendCostMs);
+		if (slot.divider == 1) {
+			_stats.slowDevices++;
+		} else if (divider == 1) {
+			_stats.slowDevices--;
+		}
+		slot.divider = divider;
+	}
+	_stats.sends++;
+	_stats.avgSendMs += (sendMs - _stats.avgSendMs) / _stats.sends;
+}
+
+void RenderEngine::transmit(DeviceSlot& slot) {
+	auto& dev = *slot.device;
+
+	if (!slot.sent) {
+		sendFull(slot);
+		return;
+	}
+
+	slot.changed.clear();
+	for (size_t i = 0; i < slot.back.size(); i++) {
+		if (slot.back[i].r != slot.front[i].r || slot.back[i].g != slot.front[i].g || slot.back[i].b != slot.front[i].b) {
+			slot.changed.push_back(i);
+		}
+	}
+
+	std::fill(slot.changedPerZone.begin(), slot.changedPerZone.end(), 0);
+	size_t zone = 0;
+	for (auto idx : slot.changed) {
+		while (zone < slot.zones.size() && idx >= slot.zones[zone].start + slot.zones[zone].count) {
+			zone++;
+		}
+		if (zone < slot.zones.size()) {
+			slot.changedPerZone[zone]++;
+		}
+	}
+
+	// Pick the cheapest mix of single LED and zone packets, a zone can only be sent whole when it ends up uniform
+	size_t ledCost	= PACKET_COST + HEADER_BYTES + COLOR_BYTES;
+	size_t fullCost	= PACKET_COST + HEADER_BYTES + (COLOR_BYTES * dev.leds.size());
+	size_t cost		= ledCost * slot.changed.size();
+	for (size_t z = 0; z < slot.zones.size(); z++) {
+		auto& span		  = slot.zones[z];
+		auto zoneCost	  = PACKET_COST + HEADER_BYTES + (COLOR_BYTES * span.count);
+		auto ledsCost	  = ledCost * slot.changedPerZone[z];
+		slot.wholeZone[z] = ledsCost > zoneCost && uniform(slot.back, span.start, span.count);
+		if (slot.wholeZone[z]) {
+			cost = cost - ledsCost + zoneCost;
+		}
+	}
+
+	if (cost >= fullCost) {
+		sendFull(slot);
+		return;
+	}
+
+	uint64_t zonePackets = 0;
+	uint64_t ledPackets	 = 0;
+	for (size_t z = 0; z < slot.zones.size(); z++) {
+		if (slot.wholeZone[z]) {
+			_client.setZoneColor(*slot.zones[z].zone, slot.out[slot.zones[z].start]);
+			zonePackets++;
+		}
+	}
+
+	zone = 0;
+	for (auto idx : slot.changed) {
+		while (zone < slot.zones.size() && idx >= slot.zones[zone].start + slot.zones[zone].count) {
+			zone++;
+		}
+		if (zone < slot.zones.size() && slot.wholeZone[zone]) {
+			continue;
+		}
+		_client.setLEDColor(dev.leds[idx], slot.out[idx]);
+		ledPackets++;
+	}
+
+	std::lock_guard<std::mutex> lock(_statsMutex);
+	_stats.zonePackets += zonePackets;
+	_stats.ledPackets += ledPackets;
+}
+
+void RenderEngine::sendFull(DeviceSlot& slot) {
+	_client.setDeviceColors(*slot.device, slot.out);
+
+	std::lock_guard<std::mutex> lock(_statsMutex);
+	_stats.fullPackets++;
+}
+
+void RenderEngine::logStats(bool debug) {
+	auto stats = getStats();
+	auto msg   = std::format("{} frames at {} FPS ({} late), {:.2f} ms avg / {:.2f} ms max per frame, {} updates sent ({:.2f} ms avg, {} full, "
+							 "{} zone, {} led packets), {} skipped, {} paced, {:.0f} ms CPU ({:.2f}%), {:.2f} ms jitter",
+							 stats.frames, stats.fps, stats.lateFrames, stats.avgFrameMs, stats.maxFrameMs, stats.sends, stats.avgSendMs,
+							 stats.fullPackets, stats.zonePackets, stats.ledPackets, stats.skipped, stats.slowDevices, stats.cpuMs,
+							 stats.cpuLoad * 100, stats.jitterMs);
+	if (debug) {
+		logger->debug(msg);
+	} else {
+		logger->info(msg);
+	}
+}
@@ -6,7 +6,7 @@
 #include "models/steam/steam_game_config.hpp"
 #include "utils/constants.hpp"
 
-RogPerfTunerClient::RogPerfTunerClient() : AbstractUnixSocketClient(Constants::SOCKET_FILE, "RogPerfTunerClient") {
+RogPerfTunerClient::RogPerfTunerClient() : AbstractUnixSocketClient(Constants::SOCKET_FILE, "RogPerfTunerClient", true) {
 }
 
 std::string RogPerfTunerClient::nextEffect() {
@@ -29,6 +29,10 @@ void RogPerfTunerClient::showGui() {
 	invoke(Constants::SHOW_GUI, {});
 }
 
+std::string RogPerfTunerClient::exportTrace(const std::string& path) {
+	return std::any_cast<std::string>(invoke(Constants::EXPORT_TRACE, {path})[0]);
+}
+
 SteamGameConfig RogPerfTunerClient::getGameConfig(const std::string& steamId) {
 	auto res	  = invoke(Constants::GAME_CFG, {steamId});
 	auto yaml_str = std::any_cast<std::string>(res[0]);
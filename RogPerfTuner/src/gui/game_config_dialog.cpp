@@ -17,7 +17,9 @@
 GameConfigDialog::GameConfigDialog(unsigned int gid, bool onGameFirstRun, QWidget* parent)
 	: Loggable("GameConfigDialog"), QDialog(parent), gid(gid), onGameFirstRun(onGameFirstRun) {
 	Logger::add_tab();
-	gameEntry = configuration.getConfiguration().games[gid];
+	auto snapshot = configuration.getConfiguration();
+	auto it		  = snapshot->games.find(gid);
+	gameEntry	  = it != snapshot->games.end() ? it->second : GameEntry{};
 	setWindowTitle(gameEntry.name.c_str());
 
 	windowLayout = new QFormLayout();
@@ -93,6 +95,23 @@ GameConfigDialog::GameConfigDialog(unsigned int gid, bool onGameFirstRun, QWidge
 	schedulerCombo->setEnabled(!performanceService.getAvailableSchedulers().empty());
 	performanceLayout->addRow(new QLabel((translator.translate("scheduler") + ":").c_str()), schedulerCombo);
 	// --- Scheduler ---
+	// --- IO preset ---
+	ioPresetCombo = new NoScrollComboBox();
+	ioPresetCombo->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+
+	ioPresetCombo->addItem(translator.translate("label.scheduler.none").c_str(), "");
+	index = 0;
+	i	  = 1;
+	for (const auto& preset : performanceService.getIoPresets()) {
+		ioPresetCombo->addItem(preset.c_str(), preset.c_str());
+		if (gameEntry.ioPreset.has_value() && gameEntry.ioPreset.value() == preset) {
+			index = i;
+		}
+		i++;
+	}
+	ioPresetCombo->setCurrentIndex(index);
+	performanceLayout->addRow(new QLabel((translator.translate("io.preset") + ":").c_str()), ioPresetCombo);
+	// --- IO preset ---
 	// --- Metrics ---
 	metricsCombo = new NoScrollComboBox();
 	metricsCombo->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
@@ -221,6 +240,10 @@ void GameConfigDialog::onAccept() {
 	if (scheduler.value().empty()) {
 		scheduler = std::nullopt;
 	}
+	std::optional<std::string> ioPreset = ioPresetCombo->currentData().toString().toStdString();
+	if (ioPreset.value().empty()) {
+		ioPreset = std::nullopt;
+	}
 
 	MangoHudLevel level = MangoHudLevel::NO_DISPLAY;
 	if (steamService.metricsEnabled()) {
@@ -238,6 +261,7 @@ void GameConfigDialog::onAccept() {
 	gameEntry.env			= envInput->text().toStdString();
 	gameEntry.wrappers		= wrappersInput->text().toStdString();
 	gameEntry.scheduler		= scheduler;
+	gameEntry.ioPreset		= ioPreset;
 	gameEntry.gpu			= gpu;
 	gameEntry.metrics_level = level;
 	gameEntry.device		= device;
@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "framework/utils/string_utils.hpp"
+#include "main/benchmark.hpp"
 #include "main/dev.hpp"
 #include "main/flatpak.hpp"
 #include "main/gui.hpp"
@@ -36,16 +37,16 @@ int main(int argc, char** argv) {
 			std::cout << "Decky plugin v" << Constants::PLUGIN_VERSION << std::endl;
 
 		} else if (arg == getShortOption(AppOptions::performance).value() || arg == getOption(AppOptions::performance)) {
-			nextProfile();
+			return nextProfile();
 
 		} else if (arg == getShortOption(AppOptions::effect).value() || arg == getOption(AppOptions::effect)) {
-			nextEffect();
+			return nextEffect();
 
 		} else if (arg == getShortOption(AppOptions::incBrightness).value() || arg == getOption(AppOptions::incBrightness)) {
-			increaseBrightness();
+			return increaseBrightness();
 
 		} else if (arg == getShortOption(AppOptions::decBrightness).value() || arg == getOption(AppOptions::decBrightness)) {
-			decreaseBrightness();
+			return decreaseBrightness();
 
 		} else if (arg == getShortOption(AppOptions::kill).value() || arg == getOption(AppOptions::kill)) {
 			return killInstance();
@@ -64,6 +65,18 @@ int main(int argc, char** argv) {
 		} else if (arg == getShortOption(AppOptions::dev_mode).value() || arg == getOption(AppOptions::dev_mode)) {
 			runDevMode();
 
+		} else if (arg == getOption(AppOptions::rgb_benchmark)) {
+			shiftArgv(argc, argv);
+			return runRgbBenchmark(argc, argv);
+
+		} else if (arg == getOption(AppOptions::hotkey_benchmark)) {
+			shiftArgv(argc, argv);
+			return runHotkeyBenchmark(argc, argv);
+
+		} else if (arg == getOption(AppOptions::trace)) {
+			shiftArgv(argc, argv);
+			exportTrace(argc, argv);
+
 		} else if (arg == getOption(AppOptions::completion)) {
 			std::string line = "";
 			for (const auto& [key, vec] : getOptionGroups()) {
@@ -1,48 +1,68 @@
 #include "servers/socket_server.hpp"
 
 #include <arpa/inet.h>
-#include <fcntl.h>
+#include <pthread.h>
 #include <qobjectdefs.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
-#include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cmath>
+#include <csignal>
 #include <cstring>
-#include <filesystem>
+#include <format>
 #include <string>
+#include <utility>
 
+#ifdef BAT_STATUS
+#include "clients/file/battery_status_client.hpp"
+#endif
 #include "framework/clients/abstract/abstract_unix_socket_client.hpp"
-#include "framework/utils/file_utils.hpp"
+#include "framework/clients/abstract/unix_message_codec.hpp"
+#include "framework/tracing/tracer.hpp"
 #include "framework/utils/yaml_utils.hpp"
 
 SocketServer::SocketServer() : Loggable("SocketServer") {
 	logger->info("Initializing socket server");
 	Logger::add_tab();
 
-	auto modTime = std::filesystem::file_time_type::min();
-	if (FileUtils::exists(Constants::SOCKET_FILE)) {
-		modTime = FileUtils::getMTime(Constants::SOCKET_FILE);
+	// A client leaving with a response pending must not kill the daemon
+	signal(SIGPIPE, SIG_IGN);
+
+	// Registered once, known methods get a topic each so they run in parallel and any other name shares one
+	for (const auto& method : {Constants::NEXT_EFF, Constants::INC_BRIGHT, Constants::DEC_BRIGHT, Constants::PERF_PROF, Constants::SHOW_GUI,
+							   Constants::EXPORT_TRACE, Constants::GAME_CFG}) {
+		requestTopics[method] = executor.registerTopic("SocketServer." + method, EventLane::REQUESTS);
 	}
+	otherRequests = executor.registerTopic("SocketServer.request", EventLane::REQUESTS);
 
 	started.store(true);
+	watchState();
 	runner = std::thread(&SocketServer::run, this);
 
-	while (true) {
-		try {
-			if (FileUtils::exists(Constants::SOCKET_FILE) && FileUtils::getMTime(Constants::SOCKET_FILE) != modTime) {
-				break;
-			}
-		} catch (std::exception& e) {
-		}
+	State result;
+	{
+		std::unique_lock<std::mutex> lock(stateMutex);
+		stateCv.wait_for(lock, START_TIMEOUT, [this] {
+			return state != State::STARTING;
+		});
+		result = state;
 	}
 
 	eventBus.onApplicationShutdown([this] {
 		stop();
 	});
 
-	logger->info("Socket server started on {}", Constants::SOCKET_FILE);
+	if (result == State::LISTENING) {
+		logger->info("Socket server started on {}", Constants::SOCKET_FILE);
+	} else if (result == State::STARTING) {
+		logger->warn("Socket server not listening after {} seconds", START_TIMEOUT.count());
+	}
 	Logger::rem_tab();
 }
 
@@ -53,31 +73,35 @@ SocketServer::~SocketServer() {
 void SocketServer::stop() {
 	logger->info("Stopping socket server");
 
-	if (!started.load()) {
+	if (!started.exchange(false)) {
 		return;
 	}
 
-	started.store(false);
-
-	if (server_fd != -1) {
-		shutdown(server_fd, SHUT_RDWR);
-		close(server_fd);
-		server_fd = -1;
-		unlink(Constants::SOCKET_FILE.c_str());
-	}
-
+	wake();
 	if (runner.joinable()) {
 		runner.join();
 	}
 
+	auto requests = std::max<uint64_t>(stats.requests, 1);
+	logger->debug("Socket metrics: {} connection(s) accepted, {} at once at most, {} request(s), {} failed, latency {:.1f}/{:.1f} ms (avg/max)",
+				  stats.accepted, stats.maxConnections, stats.requests, stats.failed, stats.latencyMs / requests, stats.maxLatencyMs);
+	logger->debug("Socket subscriptions: {} event(s) sent, {} held back", stats.events, stats.heldBack);
 	logger->info("Socket server stopped");
 }
 
-void SocketServer::run() {
-	server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
-	if (server_fd < 0) {
-		logger->error("Failed to create socket");
-		return;
+void SocketServer::setState(State value) {
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		state = value;
+	}
+	stateCv.notify_all();
+}
+
+bool SocketServer::listenSocket() {
+	serverFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (serverFd < 0) {
+		logger->error("Failed to create socket: {}", strerror(errno));
+		return false;
 	}
 
 	sockaddr_un addr{};
@@ -86,81 +110,678 @@ void SocketServer::run() {
 
 	unlink(Constants::SOCKET_FILE.c_str());
 
-	if (bind(server_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+	if (bind(serverFd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
 		logger->error("Failed to bind socket: {}", strerror(errno));
-		close(server_fd);
-		return;
+		return false;
 	}
 
-	if (listen(server_fd, 5) < 0) {
-		logger->error("Failed to listen on socket");
-		close(server_fd);
-		return;
+	if (listen(serverFd, SOMAXCONN) < 0) {
+		logger->error("Failed to listen on socket: {}", strerror(errno));
+		return false;
+	}
+
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	{
+		// State updates may be published from other threads already
+		std::lock_guard<std::mutex> lock(completionMutex);
+		wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	}
+	if (epollFd < 0 || wakeFd < 0) {
+		logger->error("Failed to create event loop: {}", strerror(errno));
+		return false;
+	}
+
+	epoll_event event{};
+	event.events   = EPOLLIN;
+	event.data.u64 = LISTEN_ID;
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, serverFd, &event) < 0) {
+		logger->error("Failed to watch socket: {}", strerror(errno));
+		return false;
+	}
+	event.data.u64 = WAKE_ID;
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) < 0) {
+		logger->error("Failed to watch wake up descriptor: {}", strerror(errno));
+		return false;
+	}
+
+	return true;
+}
+
+void SocketServer::run() {
+	pthread_setname_np(pthread_self(), "SocketServer");
+
+	if (!listenSocket()) {
+		setState(State::FAILED);
+	} else {
+		setState(State::LISTENING);
+		drainUpdates();
+
+		epoll_event events[MAX_EVENTS];
+		while (started.load()) {
+			int count = epoll_wait(epollFd, events, MAX_EVENTS, telemetryTimeout());
+			if (count < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				logger->error("Error while waiting for socket events: {}", strerror(errno));
+				break;
+			}
+
+			for (int i = 0; i < count; i++) {
+				auto id = events[i].data.u64;
+				if (id == LISTEN_ID) {
+					acceptClients();
+					continue;
+				}
+				if (id == WAKE_ID) {
+					uint64_t value;
+					read(wakeFd, &value, sizeof(value));
+					drainCompletions();
+					drainUpdates();
+					continue;
+				}
+
+				auto it = connections.find(id);
+				if (it == connections.end()) {
+					continue;
+				}
+				bool alive = true;
+				if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+					// Both directions are gone, responses can't be delivered anymore
+					alive = false;
+				} else if (events[i].events & (EPOLLIN | EPOLLRDHUP)) {
+					alive = readClient(it->second, id);
+				}
+				if (alive && (events[i].events & EPOLLOUT)) {
+					alive = writeClient(it->second, id);
+				}
+				if (!alive) {
+					closeClient(id);
+				}
+			}
+
+			publishTelemetry();
+		}
+	}
+
+	for (auto& [id, connection] : connections) {
+		close(connection.fd);
+	}
+	connections.clear();
+	stats.connections = 0;
+
+	{
+		// Requests still running on the executor find no descriptor to wake up
+		std::lock_guard<std::mutex> lock(completionMutex);
+		if (wakeFd != -1) {
+			close(wakeFd);
+			wakeFd = -1;
+		}
+		completions.clear();
+		updates.clear();
+	}
+	if (epollFd != -1) {
+		close(epollFd);
+		epollFd = -1;
 	}
+	if (serverFd != -1) {
+		close(serverFd);
+		serverFd = -1;
+		unlink(Constants::SOCKET_FILE.c_str());
+	}
+}
 
-	while (started.load()) {
-		int client_fd = accept(server_fd, nullptr, nullptr);
-		if (client_fd < 0) {
-			if (started.load()) {
+void SocketServer::acceptClients() {
+	while (true) {
+		int fd = accept4(serverFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
 				logger->error("Accept failed: {}", strerror(errno));
 			}
+			return;
+		}
+
+		auto id = nextConnection++;
+		epoll_event event{};
+		event.events   = EPOLLIN | EPOLLRDHUP;
+		event.data.u64 = id;
+		if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+			logger->error("Failed to watch client: {}", strerror(errno));
+			close(fd);
 			continue;
 		}
 
-		std::thread(&SocketServer::handleClient, this, client_fd).detach();
+		connections.emplace(id, Connection{fd});
+		stats.accepted++;
+		stats.connections	 = connections.size();
+		stats.maxConnections = std::max(stats.maxConnections, stats.connections);
 	}
 }
-void SocketServer::handleClient(int client_fd) {
+
+bool SocketServer::readClient(Connection& connection, uint64_t id) {
+	bool eof = false;
+	char buffer[64 * 1024];
 	while (true) {
-		uint32_t msg_len_net;
-		ssize_t n = read(client_fd, &msg_len_net, sizeof(msg_len_net));
-		if (n <= 0) {
+		auto n = read(connection.fd, buffer, sizeof(buffer));
+		if (n > 0) {
+			connection.input.append(buffer, n);
+			continue;
+		}
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n == 0) {
+			eof = true;
 			break;
 		}
+		// Anything other than an empty socket means the client is gone
+		if (errno != EAGAIN && errno != EWOULDBLOCK) {
+			return false;
+		}
+		break;
+	}
 
-		if (n != sizeof(msg_len_net)) {
-			logger->error("Incomplete header received");
+	size_t offset = 0;
+	while (connection.input.size() - offset >= sizeof(uint32_t)) {
+		uint32_t length;
+		std::memcpy(&length, connection.input.data() + offset, sizeof(length));
+		length = ntohl(length);
+		if (length == 0 || length > MAX_MESSAGE_BYTES) {
+			logger->error("Invalid message length: {}", length);
+			return false;
+		}
+		if (connection.input.size() - offset - sizeof(length) < length) {
 			break;
 		}
 
-		uint32_t msg_len = ntohl(msg_len_net);
-		if (msg_len == 0 || msg_len > 10 * 1024 * 1024) {
-			logger->error("Invalid message length: {}", msg_len);
-			break;
+		dispatch(id, connection.input.substr(offset + sizeof(length), length));
+		offset += sizeof(length) + length;
+	}
+	connection.input.erase(0, offset);
+
+	if (eof) {
+		// The client is done sending, it is kept until the requests it already sent are answered
+		connection.readClosed = true;
+		if (!watchClient(connection, id)) {
+			return false;
+		}
+	}
+	return !finished(connection);
+}
+
+bool SocketServer::writeClient(Connection& connection, uint64_t id) {
+	while (!connection.output.empty()) {
+		// Length prefixes and payloads of every pending response go in a single call
+		iovec iov[MAX_IOVECS];
+		int count = 0;
+		for (auto it = connection.output.begin(); it != connection.output.end() && count + 2 <= MAX_IOVECS; it++) {
+			auto sent = it->sent;
+			if (sent < sizeof(it->length)) {
+				iov[count++] = {reinterpret_cast<char*>(&it->length) + sent, sizeof(it->length) - sent};
+				sent		 = 0;
+			} else {
+				sent -= sizeof(it->length);
+			}
+			iov[count++] = {it->payload.data() + sent, it->payload.size() - sent};
+		}
+
+		auto n = writev(connection.fd, iov, count);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				break;
+			}
+			logger->error("Error while writing response: {}", strerror(errno));
+			return false;
 		}
 
-		std::string data(msg_len, '\0');
-		size_t total_read = 0;
-		while (total_read < msg_len) {
-			ssize_t r = read(client_fd, &data[total_read], msg_len - total_read);
-			if (r <= 0) {
-				logger->error("Error reading message body");
-				close(client_fd);
-				return;
+		size_t left = n;
+		while (left > 0) {
+			auto& frame	   = connection.output.front();
+			auto remaining = sizeof(frame.length) + frame.payload.size() - frame.sent;
+			if (left < remaining) {
+				frame.sent += left;
+				break;
 			}
-			total_read += r;
+			left -= remaining;
+			connection.output.pop_front();
 		}
+	}
+
+	// Topics held back while the client was slow are sent once it catches up
+	if (connection.output.empty() && queueHeldBack(connection)) {
+		return writeClient(connection, id);
+	}
+
+	// Writability is only watched while a response is waiting for room in the socket
+	bool polling = !connection.output.empty();
+	if (polling != connection.pollingOutput) {
+		connection.pollingOutput = polling;
+		if (!watchClient(connection, id)) {
+			return false;
+		}
+	}
+	return !finished(connection);
+}
+
+bool SocketServer::watchClient(Connection& connection, uint64_t id) {
+	epoll_event event{};
+	event.events   = (connection.readClosed ? 0 : EPOLLIN | EPOLLRDHUP) | (connection.pollingOutput ? EPOLLOUT : 0);
+	event.data.u64 = id;
+	if (epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event) < 0) {
+		logger->error("Failed to watch client: {}", strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+bool SocketServer::finished(const Connection& connection) {
+	return connection.readClosed && connection.pending == 0 && connection.output.empty();
+}
+
+void SocketServer::closeClient(uint64_t id) {
+	auto it = connections.find(id);
+	if (it == connections.end()) {
+		return;
+	}
+
+	epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+	close(it->second.fd);
+	connections.erase(it);
+	stats.connections = connections.size();
+}
+
+void SocketServer::flushClient(Connection& connection, uint64_t id) {
+	if (!writeClient(connection, id)) {
+		// Failed or finished, the caller may still be reading from it so the next event closes it
+		shutdown(connection.fd, SHUT_RDWR);
+	}
+}
+
+void SocketServer::dispatch(uint64_t id, std::string&& payload) {
+	auto received = Clock::now();
+	bool binary	  = UnixMessageCodec::isBinary(payload);
+
+	UnixCommunicationMessage req;
+	try {
+		req = binary ? UnixMessageCodec::decode(payload) : YamlUtils::parseYaml<UnixCommunicationMessage>(payload);
+	} catch (const std::exception& e) {
+		logger->error("Error while parsing message: {}", e.what());
+		stats.failed++;
+		return;
+	}
+
+	if (req.type != "REQUEST") {
+		return;
+	}
+	stats.requests++;
+
+	if (req.name == "ping") {
+		// Keep alive of the clients, answered right away
+		UnixCommunicationMessage res = UnixCommunicationMessage(req);
+		res.type					 = "RESPONSE";
+		res.data					 = {};
+		respond(Completion{id, received, false, binary ? UnixMessageCodec::encode(res) : YamlUtils::writeYaml(res)});
+		return;
+	}
 
-		Logger::add_tab();
+	if (req.name == Constants::SUBSCRIBE || req.name == Constants::UNSUBSCRIBE) {
+		// Subscriptions belong to the connection, so they are handled on this thread
+		auto& connection			 = connections.at(id);
+		UnixCommunicationMessage res = UnixCommunicationMessage(req);
+		res.type					 = "RESPONSE";
+		res.data					 = {};
 		try {
-			auto req = YamlUtils::parseYaml<UnixCommunicationMessage>(data);
-			if (req.type == "REQUEST") {
-				handleRequest(client_fd, req);
+			if (req.name == Constants::SUBSCRIBE) {
+				subscribe(connection, req, res, binary);
+			} else {
+				unsubscribe(connection, req, res);
+			}
+		} catch (std::exception& e) {
+			logger->error("Error on request handling: {}", e.what());
+			res.data  = {};
+			res.error = e.what();
+		}
+		respond(Completion{id, received, res.error.has_value(), binary ? UnixMessageCodec::encode(res) : YamlUtils::writeYaml(res)});
+
+		if (req.name == Constants::SUBSCRIBE && !res.error.has_value()) {
+			for (const auto& topic : res.data) {
+				notify(connection, id, std::any_cast<std::string>(topic));
+			}
+		}
+		return;
+	}
+
+	auto it = connections.find(id);
+	if (it != connections.end()) {
+		it->second.pending++;
+	}
+
+	// Requests have their own lane, so hardware events don't delay the answers
+	auto topicIt = requestTopics.find(req.name);
+	auto topic	 = topicIt != requestTopics.end() ? topicIt->second : otherRequests;
+	executor.submit(topic, EventPriority::NORMAL, false, [this, id, received, binary, req] {
+		auto res = handleRequest(req);
+		complete(Completion{id, received, res.error.has_value(), binary ? UnixMessageCodec::encode(res) : YamlUtils::writeYaml(res)});
+	});
+}
+
+void SocketServer::complete(Completion&& completion) {
+	{
+		std::lock_guard<std::mutex> lock(completionMutex);
+		completions.push_back(std::move(completion));
+	}
+	wake();
+}
+
+void SocketServer::wake() {
+	std::lock_guard<std::mutex> lock(completionMutex);
+	if (wakeFd != -1) {
+		uint64_t value = 1;
+		write(wakeFd, &value, sizeof(value));
+	}
+}
+
+void SocketServer::drainCompletions() {
+	std::vector<Completion> ready;
+	{
+		std::lock_guard<std::mutex> lock(completionMutex);
+		ready.swap(completions);
+	}
+
+	for (auto& completion : ready) {
+		auto it = connections.find(completion.connection);
+		if (it != connections.end()) {
+			it->second.pending--;
+		}
+		respond(std::move(completion));
+	}
+}
+
+void SocketServer::respond(Completion&& completion) {
+	double latencyMs = std::chrono::duration<double, std::milli>(Clock::now() - completion.received).count();
+	stats.latencyMs += latencyMs;
+	stats.maxLatencyMs = std::max(stats.maxLatencyMs, latencyMs);
+	stats.failed += completion.failed ? 1 : 0;
+
+	auto it = connections.find(completion.connection);
+	if (it == connections.end()) {
+		// The client left before its response was ready
+		return;
+	}
+
+	auto& connection = it->second;
+	connection.output.push_back(Frame{htonl(completion.payload.size()), std::move(completion.payload)});
+	flushClient(connection, completion.connection);
+}
+
+void SocketServer::watchState() {
+	topicState[TOPIC_PROFILE]	= {{"profile", toName(performanceService.getPerformanceProfile())}};
+	topicState[TOPIC_SCHEDULER] = {{"scheduler", performanceService.getCurrentScheduler()},
+								   {"ssdScheduler", performanceService.getCurrentSsdScheduler().value_or("")}};
+	topicState[TOPIC_RGB]		= {{"effect", openRgbService.getCurrentEffect()},
+								   {"brightness", toName(openRgbService.getCurrentBrightness())},
+								   {"color", openRgbService.getColor().value_or("")}};
+	topicState[TOPIC_GAMES]		= {{"running", static_cast<int>(steamService.getRunningGames().size())}};
+	topicState[TOPIC_BATTERY]	= {};
+#ifdef BAT_STATUS
+	topicState[TOPIC_BATTERY]["onBattery"] = BatteryStatusClient::getInstance().isOnBattery();
+#endif
+#ifdef BAT_LIMIT
+	topicState[TOPIC_BATTERY]["chargeThreshold"] = toName(hardwareService.getChargeThreshold());
+#endif
+
+	eventBus.onPerformanceProfile([this](PerformanceProfile profile) {
+		publish(TOPIC_PROFILE, {{"profile", toName(profile)}});
+	});
+	eventBus.onActualPerformanceProfile([this](PerformanceProfile profile) {
+		publish(TOPIC_PROFILE, {{"actualProfile", toName(profile)}});
+	});
+	eventBus.onScheduler([this](const std::optional<std::string>& scheduler) {
+		publish(TOPIC_SCHEDULER, {{"scheduler", scheduler.value_or("")}});
+	});
+	eventBus.onSsdScheduler([this](const std::string& scheduler) {
+		publish(TOPIC_SCHEDULER, {{"ssdScheduler", scheduler}});
+	});
+	eventBus.onRgbEffect([this](const std::string& effect) {
+		publish(TOPIC_RGB, {{"effect", effect}});
+	});
+	eventBus.onRgbBrightness([this](RgbBrightness brightness) {
+		publish(TOPIC_RGB, {{"brightness", toName(brightness)}});
+	});
+	eventBus.onRgbColor([this](const std::optional<std::string>& color) {
+		publish(TOPIC_RGB, {{"color", color.value_or("")}});
+	});
+	eventBus.onGameEvent([this](size_t running) {
+		publish(TOPIC_GAMES, {{"running", static_cast<int>(running)}});
+	});
+	eventBus.onBattery([this](bool onBattery) {
+		publish(TOPIC_BATTERY, {{"onBattery", onBattery}});
+	});
+#ifdef BAT_LIMIT
+	eventBus.onChargeThreshold([this](BatteryThreshold threshold) {
+		publish(TOPIC_BATTERY, {{"chargeThreshold", toName(threshold)}});
+	});
+#endif
+}
+
+void SocketServer::publish(const std::string& topic, Fields&& fields) {
+	if (!started.load()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(completionMutex);
+		updates.push_back(Update{topic, std::move(fields)});
+	}
+	wake();
+}
+
+void SocketServer::drainUpdates() {
+	std::vector<Update> ready;
+	{
+		std::lock_guard<std::mutex> lock(completionMutex);
+		ready.swap(updates);
+	}
+
+	// Updates that arrived together are merged, subscribers only get the latest values
+	std::set<std::string> changed;
+	for (auto& update : ready) {
+		auto& fields = topicState[update.topic];
+		for (auto& [key, value] : update.fields) {
+			fields[key] = std::move(value);
+		}
+		changed.insert(update.topic);
+	}
+
+	for (const auto& topic : changed) {
+		for (auto& [id, connection] : connections) {
+			notify(connection, id, topic);
+		}
+	}
+}
+
+void SocketServer::subscribe(Connection& connection, const UnixCommunicationMessage& req, UnixCommunicationMessage& res, bool binary) {
+	// Topics are strings, a number sets the telemetry interval in milliseconds
+	std::vector<std::string> topics;
+	std::optional<int> interval;
+	for (const auto& elem : req.data) {
+		if (elem.type() == typeid(std::string)) {
+			topics.push_back(std::any_cast<std::string>(elem));
+			if (!TOPICS.contains(topics.back())) {
+				throw std::runtime_error("Unknown topic " + topics.back());
 			}
-		} catch (const std::exception& e) {
-			logger->error("YAML parse error: {}", e.what());
+		} else if (elem.type() == typeid(int)) {
+			interval = std::any_cast<int>(elem);
+		} else if (elem.type() == typeid(long long)) {
+			interval = static_cast<int>(std::any_cast<long long>(elem));
+		} else {
+			throw std::runtime_error("Invalid subscription parameter");
+		}
+	}
+
+	if (!connection.subscription.has_value()) {
+		connection.subscription = Subscription{binary};
+	}
+	auto& subscription	= *connection.subscription;
+	subscription.binary = binary;
+	if (interval.has_value()) {
+		subscription.telemetryMs = std::max(*interval, MIN_TELEMETRY_MS);
+	}
+
+	for (const auto& topic : topics) {
+		if (topic == TOPIC_TELEMETRY && !subscription.topics.contains(topic)) {
+			subscription.cpu		   = CPUUsage::read();
+			subscription.nextTelemetry = Clock::now() + std::chrono::milliseconds(subscription.telemetryMs);
 		}
-		Logger::rem_tab();
+		subscription.topics.insert(topic);
+		res.data.emplace_back(topic);
 	}
+}
+
+void SocketServer::unsubscribe(Connection& connection, const UnixCommunicationMessage& req, UnixCommunicationMessage& res) {
+	if (!connection.subscription.has_value()) {
+		return;
+	}
+
+	// Without topics every subscription of the connection is removed
+	auto& subscription = *connection.subscription;
+	for (const auto& elem : req.data) {
+		auto topic = std::any_cast<std::string>(elem);
+		subscription.topics.erase(topic);
+		subscription.sent.erase(topic);
+		subscription.heldBack.erase(topic);
+		res.data.emplace_back(topic);
+	}
+	if (req.data.empty() || subscription.topics.empty()) {
+		connection.subscription.reset();
+	}
+}
+
+void SocketServer::notify(Connection& connection, uint64_t id, const std::string& topic) {
+	if (!connection.subscription.has_value() || !connection.subscription->topics.contains(topic)) {
+		return;
+	}
+	auto it = topicState.find(topic);
+	if (it == topicState.end()) {
+		return;
+	}
+
+	// A slow client would make the queue grow without limit, it gets the latest values when it catches up
+	if (connection.output.size() >= MAX_QUEUED_EVENTS) {
+		if (connection.subscription->heldBack.insert(topic).second) {
+			stats.heldBack++;
+		}
+		return;
+	}
+
+	if (queueEvent(connection, topic, it->second)) {
+		flushClient(connection, id);
+	}
+}
+
+bool SocketServer::queueEvent(Connection& connection, const std::string& topic, const Fields& fields) {
+	auto& subscription = *connection.subscription;
+	auto& sent		   = subscription.sent[topic];
+
+	UnixCommunicationMessage msg;
+	msg.type = "EVENT";
+	msg.name = topic;
+	for (const auto& [key, value] : fields) {
+		auto it = sent.find(key);
+		if (it != sent.end() && it->second == value) {
+			continue;
+		}
+		msg.data.emplace_back(key);
+		msg.data.push_back(std::visit(
+			[](const auto& v) {
+				return std::any(v);
+			},
+			value));
+		sent[key] = value;
+	}
+	if (msg.data.empty()) {
+		return false;
+	}
+
+	auto payload = subscription.binary ? UnixMessageCodec::encode(msg) : YamlUtils::writeYaml(msg);
+	connection.output.push_back(Frame{htonl(payload.size()), std::move(payload)});
+	stats.events++;
+	return true;
+}
 
-	close(client_fd);
+bool SocketServer::queueHeldBack(Connection& connection) {
+	if (!connection.subscription.has_value() || connection.subscription->heldBack.empty()) {
+		return false;
+	}
+
+	bool queued = false;
+	for (const auto& topic : std::exchange(connection.subscription->heldBack, {})) {
+		auto it = topicState.find(topic);
+		if (it != topicState.end()) {
+			queued = queueEvent(connection, topic, it->second) || queued;
+		}
+	}
+	return queued;
+}
+
+int SocketServer::telemetryTimeout() {
+	std::optional<Clock::time_point> next;
+	for (auto& [id, connection] : connections) {
+		if (connection.subscription.has_value() && connection.subscription->topics.contains(TOPIC_TELEMETRY)) {
+			next = std::min(next.value_or(Clock::time_point::max()), connection.subscription->nextTelemetry);
+		}
+	}
+	if (!next.has_value()) {
+		return -1;
+	}
+	return std::max<int64_t>(0, std::chrono::ceil<std::chrono::milliseconds>(*next - Clock::now()).count());
+}
+
+void SocketServer::publishTelemetry() {
+	auto now = Clock::now();
+	std::optional<CPUUsage> cpu;
+	for (auto& [id, connection] : connections) {
+		if (!connection.subscription.has_value() || !connection.subscription->topics.contains(TOPIC_TELEMETRY)) {
+			continue;
+		}
+		auto& subscription = *connection.subscription;
+		if (subscription.nextTelemetry > now) {
+			continue;
+		}
+		subscription.nextTelemetry = now + std::chrono::milliseconds(subscription.telemetryMs);
+
+		// Samples are dropped for slow clients, the next one covers the time since the last sent
+		if (connection.output.size() >= MAX_QUEUED_EVENTS) {
+			stats.heldBack++;
+			continue;
+		}
+
+		if (!cpu.has_value()) {
+			cpu = CPUUsage::read();
+		}
+		auto total		 = cpu->total() - subscription.cpu.total();
+		auto active		 = cpu->active() - subscription.cpu.active();
+		subscription.cpu = *cpu;
+
+		int usage = total > 0 ? static_cast<int>(std::lround(100.0 * active / total)) : 0;
+		if (queueEvent(connection, TOPIC_TELEMETRY, {{"cpu", usage}})) {
+			flushClient(connection, id);
+		}
+	}
 }
 
 void SocketServer::handleEvent(const UnixCommunicationMessage& req) {
 	eventBus.emitServerSocketEvent(req.name, req.data);
 }
 
-void SocketServer::handleRequest(int clientFd, const UnixCommunicationMessage& req) {
+UnixCommunicationMessage SocketServer::handleRequest(const UnixCommunicationMessage& req) {
+	TraceSpan span("socket", "request", std::string(req.name));
 	UnixCommunicationMessage res = UnixCommunicationMessage(req);
 	res.type					 = "RESPONSE";
 	res.data					 = {};
@@ -183,11 +804,30 @@ void SocketServer::handleRequest(int clientFd, const UnixCommunicationMessage& r
 					mainWindow.activateWindow();
 				},
 				Qt::QueuedConnection);
+		} else if (req.name == Constants::EXPORT_TRACE) {
+			// Arguments come from the client, indexing a missing one would not throw
+			if (req.data.empty() || req.data[0].type() != typeid(std::string)) {
+				res.error = "Expected the trace file path";
+				return res;
+			}
+			auto path = std::any_cast<std::string>(req.data[0]);
+			auto size = Tracer::getInstance().exportJson(path);
+			logger->info("Trace with {} events written to {}", size, path);
+			auto note = Tracer::getInstance().isEnabled() ? "" : ", recording is off, start with RCC_TRACE=1 to enable it";
+			res.data.emplace_back(std::format("{} events written to {}{}", size, path, note));
 		} else if (req.name == Constants::GAME_CFG) {
+			if (req.data.empty()) {
+				res.error = "Expected the game id";
+				return res;
+			}
+
+			// Binary clients send the id as it is, YAML turns it into a number
 			std::string idStr;
-			try {
+			if (req.data[0].type() == typeid(std::string)) {
+				idStr = std::any_cast<std::string>(req.data[0]);
+			} else if (req.data[0].type() == typeid(long long)) {
 				idStr = std::to_string(std::any_cast<long long>(req.data[0]));
-			} catch (std::exception& e) {
+			} else {
 				idStr = std::to_string(std::any_cast<uint64_t>(req.data[0]));
 			}
 			res.data.emplace_back(YamlUtils::writeYaml(steamService.getConfiguration(idStr)));
@@ -199,9 +839,5 @@ void SocketServer::handleRequest(int clientFd, const UnixCommunicationMessage& r
 		res.error = e.what();
 	}
 
-	std::string resp_str = YamlUtils::writeYaml(res);
-
-	uint32_t resp_len = htonl(resp_str.size());
-	write(clientFd, &resp_len, sizeof(resp_len));
-	write(clientFd, resp_str.c_str(), resp_str.size());
-}
\ No newline at end of file
+	return res;
+}
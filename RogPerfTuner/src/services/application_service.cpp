@@ -113,6 +113,7 @@ void ApplicationService::shutdown() {
 	logger->info("Starting application shutdown");
 	Logger::add_tab();
 	eventBus.emitApplicationShutdown();
+	configuration.flushConfig();
 	Logger::rem_tab();
 	logger->info("Shutdown finished");
 	logger->info("Stopping application");
@@ -120,12 +121,13 @@ void ApplicationService::shutdown() {
 }
 
 bool ApplicationService::isStartMinimized() {
-	return configuration.getConfiguration().application.startMinimized;
+	return configuration.getConfiguration()->application.startMinimized;
 }
 
 void ApplicationService::setStartMinimized(bool enabled) {
 	if (enabled != isStartMinimized()) {
-		configuration.getConfiguration().application.startMinimized = enabled;
-		configuration.saveConfig();
+		configuration.updateConfiguration([enabled](RootConfig& config) {
+			config.application.startMinimized = enabled;
+		});
 	}
 }
\ No newline at end of file
@@ -100,7 +100,7 @@ HardwareService::HardwareService() : Loggable("HardwareService") {
 #ifdef BAT_LIMIT
 	logger->info("Getting battery charge limit");
 	Logger::add_tab();
-	charge_limit = configuration.getConfiguration().platform.chargeLimit;
+	charge_limit = configuration.getConfiguration()->platform.chargeLimit;
 	batteryChargeLimitClient.setChargeLimit(charge_limit);
 	logger->info(std::to_string(toInt(charge_limit)) + "%");
 	Logger::rem_tab();
@@ -123,18 +123,23 @@ HardwareService::HardwareService() : Loggable("HardwareService") {
 }
 
 void HardwareService::setupDeviceLoop() {
-	connectedDevices = std::get<0>(udevClient.compare_connected_devs({}, [this](const UsbIdentifier& dev) {
-		return !openRgbService.getDeviceName(dev).empty();
-	}));
-	eventBus.onDeviceEvent([this]() {
-		onDeviceEvent();
+	eventBus.onDeviceEvent([this](const std::vector<UsbIdentifier>& added, const std::vector<UsbIdentifier>& removed) {
+		onDeviceEvent(added, removed);
 	});
 }
 
-void HardwareService::onDeviceEvent() {
-	auto [current, added, removed] = udevClient.compare_connected_devs(connectedDevices, [this](const UsbIdentifier& dev) {
-		return !openRgbService.getDeviceName(dev).empty();
-	});
+void HardwareService::onDeviceEvent(const std::vector<UsbIdentifier>& addedDevices, const std::vector<UsbIdentifier>& removedDevices) {
+	auto compatible = [this](const std::vector<UsbIdentifier>& devices) {
+		std::vector<UsbIdentifier> result;
+		for (auto& dev : devices) {
+			if (!openRgbService.getDeviceName(dev).empty()) {
+				result.push_back(dev);
+			}
+		}
+		return result;
+	};
+	auto added	 = compatible(addedDevices);
+	auto removed = compatible(removedDevices);
 
 	if (added.size() > 0) {
 		logger->info("Added compatible device(s):");
@@ -159,8 +164,6 @@ void HardwareService::onDeviceEvent() {
 	} else if (removed.size() > 0) {
 		eventBus.emitUsbRemoved(removed);
 	}
-
-	connectedDevices = current;
 }
 
 #ifdef BAT_LIMIT
@@ -176,9 +179,10 @@ void HardwareService::setChargeThreshold(BatteryThreshold threshold) {
 		batteryChargeLimitClient.setChargeLimit(threshold);
 		auto t1 = TimeUtils::now();
 
-		charge_limit										  = threshold;
-		configuration.getConfiguration().platform.chargeLimit = threshold;
-		configuration.saveConfig();
+		charge_limit = threshold;
+		configuration.updateConfiguration([threshold](RootConfig& config) {
+			config.platform.chargeLimit = threshold;
+		});
 
 		logger->info("Charge limit setted after {} seconds", TimeUtils::format_seconds(TimeUtils::getTimeDiff(t0, t1)));
 
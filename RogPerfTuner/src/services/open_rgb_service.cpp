@@ -13,15 +13,27 @@ OpenRgbService::OpenRgbService() : Loggable("OpenRgbService") {
 	logger->info("Initializing OpenRgbService");
 	Logger::add_tab();
 
+	auto snapshot = configuration.getConfiguration();
+	openRgbClient.setFps(snapshot->aura.fps);
+	openRgbClient.setCorrections(snapshot->aura.corrections);
 	openRgbClient.initialize();
 
 	restoreAura();
 
 	eventBus.onBattery([this](bool onBat) {
+		openRgbClient.getFpsGovernor().setOnBattery(onBat);
 		auto brightness = onBat ? RgbBrightness::OFF : this->brightness;
 		openRgbClient.applyEffect(effect, brightness, _color);
 	});
 
+	eventBus.onGameEvent([this](size_t runningGames) {
+		openRgbClient.getFpsGovernor().setGaming(runningGames > 0);
+	});
+
+	eventBus.onActualPerformanceProfile([this](PerformanceProfile profile) {
+		openRgbClient.getFpsGovernor().setQuiet(profile == PerformanceProfile::QUIET);
+	});
+
 	eventBus.onUsbAdded([this]() {
 		reload();
 	});
@@ -36,12 +48,13 @@ OpenRgbService::OpenRgbService() : Loggable("OpenRgbService") {
 }
 
 void OpenRgbService::restoreAura() {
-	effect	   = configuration.getConfiguration().aura.last_effect.value_or("Static");
-	brightness = configuration.getConfiguration().aura.brightness;
-	_color	   = std::nullopt;
+	auto snapshot = configuration.getConfiguration();
+	effect		  = snapshot->aura.last_effect.value_or("Static");
+	brightness	  = snapshot->aura.brightness;
+	_color		  = std::nullopt;
 
-	auto it = configuration.getConfiguration().aura.config.find(effect);
-	if (it != configuration.getConfiguration().aura.config.end()) {
+	auto it = snapshot->aura.config.find(effect);
+	if (it != snapshot->aura.config.end()) {
 		_color = it->second.color;
 	}
 
@@ -101,9 +114,10 @@ void OpenRgbService::setEffect(const std::string& newEffect, bool temporal) {
 	if (effect != newEffect) {
 		effect = newEffect;
 
-		_color	= std::nullopt;
-		auto it = configuration.getConfiguration().aura.config.find(effect);
-		if (it != configuration.getConfiguration().aura.config.end()) {
+		auto snapshot = configuration.getConfiguration();
+		_color		  = std::nullopt;
+		auto it		  = snapshot->aura.config.find(effect);
+		if (it != snapshot->aura.config.end()) {
 			_color = it->second.color;
 		}
 
@@ -129,11 +143,14 @@ void OpenRgbService::setColor(const std::string& color) {
 
 void OpenRgbService::reload() {
 	auto t0 = TimeUtils::now();
-	logger->info("Reloading OpenRGB server");
+	logger->info("Reloading OpenRGB devices");
 	Logger::add_tab();
-	openRgbClient.stop();
-	openRgbClient.start();
-	applyAura();
+	if (!openRgbClient.rescanDevices()) {
+		logger->warn("Rescan failed, restarting OpenRGB server");
+		openRgbClient.stop();
+		openRgbClient.start();
+		applyAura();
+	}
 	auto t1 = TimeUtils::now();
 	Logger::rem_tab();
 	logger->info("Reloaded after {} seconds", TimeUtils::format_seconds(TimeUtils::getTimeDiff(t0, t1)));
@@ -146,19 +163,19 @@ void OpenRgbService::applyAura(bool temporal) {
 	openRgbClient.applyEffect(effect, brightness, _color);
 
 	if (!temporal) {
-		configuration.getConfiguration().aura.brightness  = brightness;
-		configuration.getConfiguration().aura.last_effect = effect;
-
-		if (_color.has_value()) {
-			auto it = configuration.getConfiguration().aura.config.find(effect);
-			if (it != configuration.getConfiguration().aura.config.end()) {
-				it->second.color = _color.value();
-			} else {
-				configuration.getConfiguration().aura.config[effect] = EffectConfig(_color.value());
+		configuration.updateConfiguration([this](RootConfig& config) {
+			config.aura.brightness	= brightness;
+			config.aura.last_effect = effect;
+
+			if (_color.has_value()) {
+				auto it = config.aura.config.find(effect);
+				if (it != config.aura.config.end()) {
+					it->second.color = _color.value();
+				} else {
+					config.aura.config[effect] = EffectConfig(_color.value());
+				}
 			}
-		}
-
-		configuration.saveConfig();
+		});
 	}
 
 	auto t1 = TimeUtils::now();
@@ -6,6 +6,7 @@
 
 #include "framework/logger/logger.hpp"
 #include "framework/models/cpu_usage.hpp"
+#include "framework/tracing/tracer.hpp"
 #include "framework/utils/enum_utils.hpp"
 #include "framework/utils/process_utils.hpp"
 #include "framework/utils/string_utils.hpp"
@@ -20,8 +21,9 @@ PerformanceService::PerformanceService() : Loggable("PerformanceService") {
 	logger->info("Initializing PerformanceService");
 	Logger::add_tab();
 
-	currentProfile	 = configuration.getConfiguration().platform.performance.profile;
-	currentScheduler = configuration.getConfiguration().platform.performance.scheduler.value_or("");
+	auto snapshot	 = configuration.getConfiguration();
+	currentProfile	 = snapshot->platform.performance.profile;
+	currentScheduler = snapshot->platform.performance.scheduler.value_or("");
 
 #ifdef BAT_STATUS
 	onBattery		 = batteryStatusClient.isOnBattery();
@@ -45,9 +47,10 @@ PerformanceService::PerformanceService() : Loggable("PerformanceService") {
 	}
 	if (currentScheduler.empty() ||
 		std::find(availableSchedulers.begin(), availableSchedulers.end(), currentScheduler) == availableSchedulers.end()) {
-		currentScheduler												= defaultScheduler;
-		configuration.getConfiguration().platform.performance.scheduler = currentScheduler;
-		configuration.saveConfig();
+		currentScheduler = defaultScheduler;
+		configuration.updateConfiguration([this](RootConfig& config) {
+			config.platform.performance.scheduler = currentScheduler;
+		});
 	}
 
 #ifdef FAN_CONTROL
@@ -56,19 +59,19 @@ PerformanceService::PerformanceService() : Loggable("PerformanceService") {
 	for (PerformanceProfile profile : values<PerformanceProfile>()) {
 		auto platformProfile = getPlatformProfile(profile);
 
-		auto it = configuration.getConfiguration().platform.curves.find(toString(profile));
-		if (it == configuration.getConfiguration().platform.curves.end()) {
-			configuration.getConfiguration().platform.curves[toString(profile)] = {};
-
+		snapshot = configuration.getConfiguration();
+		auto it	 = snapshot->platform.curves.find(toString(profile));
+		if (it == snapshot->platform.curves.end()) {
 			asusCtlClient.setCurvesToDefaults(platformProfile);
 			auto data = asusCtlClient.getFanCurveData(platformProfile);
-			for (auto& [fan, curve] : data) {
-				configuration.getConfiguration().platform.curves[toString(profile)][fan].presets = curve.toData();
-				curve.normalize();
-				configuration.getConfiguration().platform.curves[toString(profile)][fan].current = curve.toData();
-			}
-
-			configuration.saveConfig();
+			configuration.updateConfiguration([&profile, &data](RootConfig& config) {
+				auto& curves = config.platform.curves[toString(profile)];
+				for (auto& [fan, curve] : data) {
+					curves[fan].presets = curve.toData();
+					curve.normalize();
+					curves[fan].current = curve.toData();
+				}
+			});
 		} else {
 			for (const auto& [fan, curve] : it->second) {
 				asusCtlClient.setFanCurveStringData(platformProfile, fan, curve.current);
@@ -76,8 +79,9 @@ PerformanceService::PerformanceService() : Loggable("PerformanceService") {
 		}
 	}
 	std::vector<std::string> fans = {};
-	if (configuration.getConfiguration().platform.curves.size() > 0) {
-		for (const auto& [_, curves] : configuration.getConfiguration().platform.curves) {
+	snapshot					  = configuration.getConfiguration();
+	if (snapshot->platform.curves.size() > 0) {
+		for (const auto& [_, curves] : snapshot->platform.curves) {
 			for (const auto& [fan, _] : curves) {
 				fans.emplace_back(fan);
 			}
@@ -100,6 +104,23 @@ PerformanceService::PerformanceService() : Loggable("PerformanceService") {
 		Logger::rem_tab();
 	}
 
+	if (blockDeviceClient.available()) {
+		logger->info("Block devices:");
+		Logger::add_tab();
+		logger->info(StringUtils::join(blockDeviceClient.getDevices(), ", "));
+		if (!blockDeviceClient.getSteamDevices().empty()) {
+			logger->info("Steam libraries on {}", StringUtils::join(blockDeviceClient.getSteamDevices(), ", "));
+		}
+		Logger::rem_tab();
+
+		if (!configuration.getConfiguration()->platform.performance.ioPresets.contains(GAME_LOADING_IO_PRESET)) {
+			configuration.updateConfiguration([](RootConfig& config) {
+				config.platform.performance.ioPresets[GAME_LOADING_IO_PRESET] = {
+					{BlockDeviceTuning::STEAM_DEVICES, BlockDeviceTuning{.readAheadKb = 2048, .wbtLatUsec = 0}}};
+			});
+		}
+	}
+
 	platformClient.setChangePlatformProfileOnAc(false);
 	platformClient.setChangePlatformProfileOnBattery(false);
 	platformClient.setPlatformProfileLinkedEpp(false);
@@ -163,10 +184,11 @@ void PerformanceService::setActualPerformanceProfile(PerformanceProfile profile)
 #ifdef FAN_CONTROL
 		setFanCurves(profile, actualProfile);
 #endif
+		setIoPreset(profile);
 		auto t1 = TimeUtils::now();
 		logger->info("Profile applied after {} seconds", TimeUtils::format_seconds(TimeUtils::getTimeDiff(t0, t1)));
 		actualProfile = profile;
-
+		eventBus.emitActualPerformanceProfile(profile);
 	} catch (std::exception& e) {
 	}
 	Logger::rem_tab();
@@ -228,6 +250,7 @@ void PerformanceService::smartWorker() {
 void PerformanceService::setPerformanceProfile(PerformanceProfile profile, bool temporal, bool force, bool showToast) {
 	std::lock_guard<std::mutex> lock(perProfMutex);
 	std::string profileName = toName(profile);
+	TraceSpan span("profile", "setPerformanceProfile", std::string(profileName));
 
 	if (profile != currentProfile || force) {
 		logger->info("Setting {} profile", profileName);
@@ -252,8 +275,9 @@ void PerformanceService::setPerformanceProfile(PerformanceProfile profile, bool
 		}
 
 		if (!temporal) {
-			configuration.getConfiguration().platform.performance.profile = profile;
-			configuration.saveConfig();
+			configuration.updateConfiguration([&profile](RootConfig& config) {
+				config.platform.performance.profile = profile;
+			});
 		}
 
 		if (showToast) {
@@ -286,6 +310,41 @@ void PerformanceService::setPlatformProfile(PerformanceProfile profile) {
 	}
 }
 
+void PerformanceService::setIoPreset(PerformanceProfile profile) {
+	if (!blockDeviceClient.available()) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(ioPresetMutex);
+	auto snapshot		  = configuration.getConfiguration();
+	const auto& ioPresets = snapshot->platform.performance.ioPresets;
+
+	IoPreset preset;
+	auto it = ioPresets.find(toString(profile));
+	if (it != ioPresets.end()) {
+		preset = it->second;
+	}
+	if (gameIoPreset.has_value()) {
+		auto gameIt = ioPresets.find(*gameIoPreset);
+		if (gameIt != ioPresets.end()) {
+			for (const auto& [device, tuning] : gameIt->second) {
+				preset[device].merge(tuning);
+			}
+		} else {
+			logger->warn("IO preset {} not found", *gameIoPreset);
+		}
+	}
+
+	logger->info("IO preset: {}", gameIoPreset.value_or(it != ioPresets.end() ? it->first : "default"));
+	Logger::add_tab();
+	try {
+		blockDeviceClient.apply(preset);
+	} catch (std::exception& e) {
+		logger->error("Error while applying IO preset: {}", e.what());
+	}
+	Logger::rem_tab();
+}
+
 #ifdef BOOST_CONTROL
 void PerformanceService::setBoost(PerformanceProfile) {
 	bool enabled = onBattery ? batteryBoost() : acBoost();
@@ -401,15 +460,17 @@ void PerformanceService::setNvidiaProfile(PerformanceProfile profile) {
 #endif
 
 void PerformanceService::restore() {
+	TraceSpan span("profile", "restore");
 	if (onBattery) {
 		PerformanceProfile p = PerformanceProfile::QUIET;
 		setPerformanceProfile(p, true, true);
 	} else {
-		setPerformanceProfile(configuration.getConfiguration().platform.performance.profile, false, true);
+		setPerformanceProfile(configuration.getConfiguration()->platform.performance.profile, false, true);
 	}
 
-	setScheduler(configuration.getConfiguration().platform.performance.scheduler.value_or(currentScheduler));
-	setSsdScheduler(configuration.getConfiguration().platform.performance.ssdScheduler);
+	auto snapshot = configuration.getConfiguration();
+	setScheduler(snapshot->platform.performance.scheduler.value_or(currentScheduler));
+	setSsdScheduler(snapshot->platform.performance.ssdScheduler);
 }
 
 PerformanceProfile PerformanceService::nextPerformanceProfile() {
@@ -537,6 +598,7 @@ std::string PerformanceService::getDefaultScheduler() {
 }
 
 void PerformanceService::setScheduler(const std::string& scheduler, bool temporal) {
+	TraceSpan span("profile", "setScheduler", std::string(scheduler));
 	logger->info("Applying {} scheduler", scheduler);
 	Logger::add_tab();
 
@@ -565,8 +627,9 @@ void PerformanceService::setScheduler(const std::string& scheduler, bool tempora
 		currentScheduler = scheduler;
 
 		if (!temporal) {
-			configuration.getConfiguration().platform.performance.scheduler = scheduler;
-			configuration.saveConfig();
+			configuration.updateConfiguration([&scheduler](RootConfig& config) {
+				config.platform.performance.scheduler = scheduler;
+			});
 		}
 
 		auto t1 = TimeUtils::now();
@@ -598,18 +661,22 @@ void PerformanceService::setSsdScheduler(const std::string& scheduler, bool temp
 		return;
 	}
 
+	TraceSpan span("profile", "setSsdScheduler", std::string(scheduler));
 	logger->info("Applying {} SSD scheduler", scheduler);
 	Logger::add_tab();
 	if (scheduler == currentSsdScheduler) {
 		logger->info("Scheduler already applied");
 	} else {
 		auto t0 = TimeUtils::now();
-		ssdSchedulerClient.setSchedulers(scheduler);
+		// Written through the block device tuning so IO presets restore it instead of the boot value
+		blockDeviceClient.setDefaults("nvme", BlockDeviceTuning{.scheduler = scheduler});
+		setIoPreset(actualProfile);
 		currentSsdScheduler = scheduler;
 
 		if (!temporal) {
-			configuration.getConfiguration().platform.performance.ssdScheduler = scheduler;
-			configuration.saveConfig();
+			configuration.updateConfiguration([&scheduler](RootConfig& config) {
+				config.platform.performance.ssdScheduler = scheduler;
+			});
 		}
 		auto t1 = TimeUtils::now();
 		logger->info("Scheduler applied after {} seconds", TimeUtils::format_seconds(TimeUtils::getTimeDiff(t0, t1)));
@@ -619,17 +686,45 @@ void PerformanceService::setSsdScheduler(const std::string& scheduler, bool temp
 	eventBus.emitSsdScheduler(scheduler);
 }
 
+std::vector<std::string> PerformanceService::getIoPresets() {
+	std::vector<std::string> result;
+	// Keeps the snapshot alive while iterating, the temporary would be released before the loop
+	auto config = configuration.getConfiguration();
+	for (const auto& [name, _] : config->platform.performance.ioPresets) {
+		result.emplace_back(name);
+	}
+	return result;
+}
+
+void PerformanceService::setGameIoPreset(const std::optional<std::string>& preset) {
+	// Only recorded, the profile switch that follows it applies the preset once with the rest of the profile
+	std::lock_guard<std::mutex> lock(ioPresetMutex);
+	gameIoPreset = preset;
+}
+
 #ifdef FAN_CONTROL
 std::vector<std::string> PerformanceService::getFans() {
 	return asusCtlClient.getFans(getPlatformProfile(actualProfile));
 }
 
 FanCurveData PerformanceService::getFanCurve(const std::string& fan, const std::string& profile) {
-	return FanCurveData::fromData(configuration.getConfiguration().platform.curves[profile][fan].current);
+	return FanCurveData::fromData(getConfiguredCurve(fan, profile).current);
 }
 
 FanCurveData PerformanceService::getDefaultFanCurve(const std::string& fan, const std::string& profile) {
-	return FanCurveData::fromData(configuration.getConfiguration().platform.curves[profile][fan].presets);
+	return FanCurveData::fromData(getConfiguredCurve(fan, profile).presets);
+}
+
+FanCurve PerformanceService::getConfiguredCurve(const std::string& fan, const std::string& profile) {
+	auto snapshot = configuration.getConfiguration();
+	auto curves	  = snapshot->platform.curves.find(profile);
+	if (curves != snapshot->platform.curves.end()) {
+		auto it = curves->second.find(fan);
+		if (it != curves->second.end()) {
+			return it->second;
+		}
+	}
+	return FanCurve{};
 }
 
 void PerformanceService::saveFanCurves(std::map<std::string, std::unordered_map<std::string, FanCurveData>> curves) {
@@ -639,13 +734,18 @@ void PerformanceService::saveFanCurves(std::map<std::string, std::unordered_map<
 		logger->info("Saving curves for {}", StringUtils::toUpperCase(profile));
 		Logger::add_tab();
 
+		std::unordered_map<std::string, std::string> saved;
 		for (const auto& [fan, curve] : curves) {
 			auto data = curve.toData();
 			logger->info("{}: {}", fan, data);
 			asusCtlClient.setFanCurveStringData(fromString<PlatformProfile>(profile), fan, data);
-			configuration.getConfiguration().platform.curves[profile][fan].current = data;
+			saved[fan] = data;
 		}
-		configuration.saveConfig();
+		configuration.updateConfiguration([&profile, &saved](RootConfig& config) {
+			for (const auto& [fan, data] : saved) {
+				config.platform.curves[profile][fan].current = data;
+			}
+		});
 
 		Logger::rem_tab();
 	}
@@ -665,8 +765,12 @@ void PerformanceService::setFanCurves(PerformanceProfile profile, PerformancePro
 	Logger::add_tab();
 	try {
 		asusCtlClient.setFanCurvesEnabled(getPlatformProfile(previous), false);
-		for (const auto& [fan, data] : configuration.getConfiguration().platform.curves[toString(profile)]) {
-			logger->info(fan + ": " + StringUtils::replaceAll(data.current, ",", " "));
+		auto snapshot = configuration.getConfiguration();
+		auto curves	  = snapshot->platform.curves.find(toString(profile));
+		if (curves != snapshot->platform.curves.end()) {
+			for (const auto& [fan, data] : curves->second) {
+				logger->info(fan + ": " + StringUtils::replaceAll(data.current, ",", " "));
+			}
 		}
 		asusCtlClient.setFanCurvesEnabled(platformProfile, true);
 	} catch (std::exception& e) {
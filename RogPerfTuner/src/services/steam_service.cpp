@@ -14,6 +14,7 @@
 #ifndef DEV_MODE
 #include "gui/yes_no_dialog.hpp"
 #endif
+#include "framework/tracing/tracer.hpp"
 #include "framework/utils/file_utils.hpp"
 #include "framework/utils/net_utils.hpp"
 #include "framework/utils/process_utils.hpp"
@@ -42,8 +43,8 @@ const std::unordered_map<unsigned int, GameEntry>& SteamService::getRunningGames
 	return runningGames;
 }
 
-const std::map<uint, GameEntry>& SteamService::getGames() {
-	return configuration.getConfiguration().games;
+std::map<uint, GameEntry> SteamService::getGames() {
+	return configuration.getConfiguration()->games;
 }
 
 SteamService::SteamService() : Loggable("SteamService") {
@@ -153,6 +154,7 @@ void SteamService::onFirstGameRun(unsigned int gid, std::string name, bool proto
 					env,
 					std::nullopt,
 					std::nullopt,
+					std::nullopt,
 					MangoHudLevel::NO_DISPLAY,
 					name,
 					details.is_shortcut ? std::optional<std::string>{encodedAppId} : std::nullopt,
@@ -160,8 +162,9 @@ void SteamService::onFirstGameRun(unsigned int gid, std::string name, bool proto
 					ComputerType::COMPUTER,
 					WineSyncOption::AUTO,
 					wrappers};
-	configuration.getConfiguration().games[gid] = entry;
-	configuration.saveConfig();
+	configuration.updateConfiguration([gid, &entry](RootConfig& config) {
+		config.games[gid] = entry;
+	});
 
 	auto userIds = FileUtils::listDirectory(Constants::STEAM_USERDATA_PATH);
 	for (const auto& userId : userIds) {
@@ -216,8 +219,9 @@ void SteamService::saveGameConfig(uint gid, GameEntry entry) {
 	logger->info("Saving configuration for {} ({})", entry.name, gid);
 	Logger::add_tab();
 
-	configuration.getConfiguration().games[gid] = entry;
-	configuration.saveConfig();
+	configuration.updateConfiguration([gid, &entry](RootConfig& config) {
+		config.games[gid] = entry;
+	});
 
 	Logger::rem_tab();
 }
@@ -245,7 +249,7 @@ void SteamService::installRccDC() {
 		if (FileUtils::exists(Constants::DECKY_SERVICE_PATH)) {
 			if (!FileUtils::exists(Constants::RCCDC_PATH)) {
 #ifndef DEV_MODE
-				if (!configuration.getConfiguration().application.askedInstallRccdc &&
+				if (!configuration.getConfiguration()->application.askedInstallRccdc &&
 					YesNoDialog::showDialog(translator.translate("enable.decky.integration.title"),
 											translator.translate("enable.decky.integration.body"))) {
 #endif
@@ -256,8 +260,9 @@ void SteamService::installRccDC() {
 #ifndef DEV_MODE
 				}
 #endif
-				configuration.getConfiguration().application.askedInstallRccdc = true;
-				configuration.saveConfig();
+				configuration.updateConfiguration([](RootConfig& config) {
+					config.application.askedInstallRccdc = true;
+				});
 			} else {
 				if (checkIfRequiredInstallation()) {
 					logger->info("Updating Decky plugin");
@@ -267,8 +272,9 @@ void SteamService::installRccDC() {
 				} else {
 					logger->info("Plugin up to date");
 				}
-				configuration.getConfiguration().application.askedInstallRccdc = true;
-				configuration.saveConfig();
+				configuration.updateConfiguration([](RootConfig& config) {
+					config.application.askedInstallRccdc = true;
+				});
 			}
 			rccdcEnabled = true;
 		} else {
@@ -299,11 +305,13 @@ void SteamService::copyPlugin() {
 }
 
 void SteamService::onGameLaunch(unsigned int gid, std::string name, int pid) {
+	TraceSpan span("steam", "onGameLaunch", std::string(name));
 	logger->info("Launched {} ({}) with PID {}", name, gid, pid);
 	Logger::add_tab();
 
-	auto it = configuration.getConfiguration().games.find(gid);
-	if (it == configuration.getConfiguration().games.end()) {
+	auto config = configuration.getConfiguration();
+	auto it		= config->games.find(gid);
+	if (it == config->games.end()) {
 		logger->info("Game not configured");
 		Logger::add_tab();
 
@@ -347,6 +355,7 @@ void SteamService::onGameLaunch(unsigned int gid, std::string name, int pid) {
 }
 
 void SteamService::onGameStop(unsigned int gid, std::string name) {
+	TraceSpan span("steam", "onGameStop", std::string(name));
 	auto it = runningGames.find(gid);
 	if (it != runningGames.end()) {
 		logger->info("Stopped '{}' ({})", name, gid);
@@ -372,15 +381,26 @@ void SteamService::onGameStop(unsigned int gid, std::string name) {
 }
 
 void SteamService::setProfileForGames(bool onConnect) {
+	TraceSpan span("steam", "setProfileForGames");
 	if (!runningGames.empty()) {
 #ifdef PANEL_OD
 		hardwareService.setPanelOverdrive(true);
 #endif
 		openRgbService.setEffect("Gaming", true);
+
+		std::optional<std::string> ioPreset = std::nullopt;
+		for (const auto& [key, value] : runningGames) {
+			if (value.ioPreset.has_value()) {
+				ioPreset = value.ioPreset;
+				break;
+			}
+		}
+		performanceService.setGameIoPreset(ioPreset);
+
 		PerformanceProfile p = PerformanceProfile::PERFORMANCE;
 		performanceService.setPerformanceProfile(p, true, true);
 
-		std::optional<std::string> sched = configuration.getConfiguration().platform.performance.scheduler;
+		std::optional<std::string> sched = configuration.getConfiguration()->platform.performance.scheduler;
 		for (const auto& [key, value] : runningGames) {
 			if (value.scheduler.has_value() && value.scheduler != performanceService.getCurrentScheduler()) {
 				sched = *value.scheduler;
@@ -393,6 +413,7 @@ void SteamService::setProfileForGames(bool onConnect) {
 		hardwareService.setPanelOverdrive(false);
 #endif
 		openRgbService.restoreAura();
+		performanceService.setGameIoPreset(std::nullopt);
 		performanceService.restore();
 	}
 }
@@ -411,6 +432,7 @@ void SteamService::onDisconnect() {
 	logger->info("Disconnected from Steam");
 	Logger::add_tab();
 	if (!runningGames.empty()) {
+		performanceService.setGameIoPreset(std::nullopt);
 		performanceService.restore();
 		openRgbService.restoreAura();
 		runningGames.clear();
@@ -421,14 +443,15 @@ void SteamService::onDisconnect() {
 const SteamGameConfig SteamService::getConfiguration(const std::string& id) {
 	SteamGameConfig cfg;
 
-	auto games = configuration.getConfiguration().games;
-	auto it	   = games.find(std::stoul(id));
+	auto config	= configuration.getConfiguration();
+	auto& games	= config->games;
+	auto it		= games.find(std::stoul(id));
 
 	std::optional<GameEntry> entry = std::nullopt;
 	if (it != games.end()) {
 		entry = it->second;
 	} else {
-		for (const auto& [key, val] : configuration.getConfiguration().games) {
+		for (const auto& [key, val] : games) {
 			if (val.overlayId.has_value() && val.overlayId == id) {
 				entry = val;
 				break;
@@ -14,10 +14,14 @@
 const QString service = Constants::EXEC_NAME.c_str();
 const QString key	  = "password";
 
-RootConfig& ConfigurationWrapper::getConfiguration() {
+std::shared_ptr<const RootConfig> ConfigurationWrapper::getConfiguration() {
 	return this->config.getConfiguration();
 }
 
+void ConfigurationWrapper::updateConfiguration(const std::function<void(RootConfig&)>& mutator) {
+	this->config.update(mutator);
+}
+
 std::string ConfigurationWrapper::getPassword() {
 	QKeychain::ReadPasswordJob job(service);
 	job.setKey(key);
@@ -58,6 +62,10 @@ void ConfigurationWrapper::saveConfig() {
 	this->config.saveConfig();
 }
 
+void ConfigurationWrapper::flushConfig() {
+	this->config.flush();
+}
+
 void ConfigurationWrapper::loadConfig() {
 	this->config.loadConfig();
 }
\ No newline at end of file
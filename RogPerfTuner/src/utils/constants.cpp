@@ -50,16 +50,21 @@ const std::string Constants::INCREASE_BRIGHTNESS_PATH = HOME_DIR + "/." + APP_NA
 const std::string Constants::NEXT_EFFECT_PATH		  = HOME_DIR + "/." + APP_NAME + "/bin/rgb/nextEffect";
 const std::string Constants::CONFIG_DIR				  = HOME_DIR + "/." + APP_NAME + "/config";
 const std::string Constants::CONFIG_FILE			  = "config.yaml";
+const std::string Constants::ORGB_DEVICES_FILE		  = HOME_DIR + "/." + APP_NAME + "/config/openrgb-devices.txt";
 const std::string Constants::LOGOS_DIR				  = HOME_DIR + "/." + APP_NAME + "/logos";
 const std::string Constants::LIB_DIR				  = HOME_DIR + "/." + APP_NAME + "/lib";
 const std::string Constants::LOG_DIR				  = HOME_DIR + "/." + APP_NAME + "/logs";
 const std::string Constants::LOG_OLD_DIR			  = HOME_DIR + "/." + APP_NAME + "/logs/old";
+const std::string Constants::TRACE_FILE				  = HOME_DIR + "/." + APP_NAME + "/logs/trace.json";
 const std::string Constants::AUTOSTART_FILE			  = HOME_DIR + "/.config/autostart/" + APP_NAME + ".desktop";
 const std::string Constants::PERF_PROF				  = "nexPerformanceProfile";
 const std::string Constants::DEC_BRIGHT				  = "decRgbBrightness";
 const std::string Constants::INC_BRIGHT				  = "incRgbBrightness";
 const std::string Constants::NEXT_EFF				  = "nextRgbEffect";
 const std::string Constants::SHOW_GUI				  = "showGui";
+const std::string Constants::EXPORT_TRACE			  = "exportTrace";
+const std::string Constants::SUBSCRIBE				  = "subscribe";
+const std::string Constants::UNSUBSCRIBE			  = "unsubscribe";
 
 const std::string Constants::PLUGIN_VERSION			   = M_PLUGIN_VERSION;
 const std::string Constants::USR_SHARE_OCL_DIR		   = "/etc/OpenCL/vendors/";
@@ -69,10 +74,12 @@ const std::string Constants::RCCDC_ASSET_PATH		   = ASSETS_DIR + "/RccDeckyCompa
 const std::string Constants::BIN_STEAM_DIR			   = HOME_DIR + "/." + APP_NAME + "/bin/steam";
 const std::string Constants::STEAM_WRAPPER_PATH		   = HOME_DIR + "/." + APP_NAME + "/bin/steam/run";
 const std::string Constants::FLATPAK_WRAPPER_PATH	   = HOME_DIR + "/." + APP_NAME + "/bin/steam/flatpak";
+const std::string Constants::LAUNCH_CACHE_DIR		   = HOME_DIR + "/." + APP_NAME + "/cache/launch";
 const std::string Constants::LIB_VK_DIR				   = HOME_DIR + "/." + APP_NAME + "/lib/vk/icd.d/";
 const std::string Constants::LIB_OCL_DIR			   = HOME_DIR + "/." + APP_NAME + "/lib/ocl/icd.d/";
 const std::string Constants::USER_PLUGIN_DIR		   = HOME_DIR + "/." + APP_NAME + "/plugin";
 const std::string Constants::STEAM_USERDATA_PATH	   = HOME_DIR + "/.steam/steam/userdata";
+const std::string Constants::STEAM_LIBRARIES_FILE	   = HOME_DIR + "/.steam/steam/steamapps/libraryfolders.vdf";
 const std::string Constants::PLUGINS_FOLDER			   = HOME_DIR + "/homebrew/plugins";
 const std::string Constants::RCCDC_PATH				   = HOME_DIR + "/homebrew/plugins/RCCDeckyCompanion";
 const std::string Constants::RCCDC_PACKAGE_FILE		   = HOME_DIR + "/homebrew/plugins/RCCDeckyCompanion/package.json";
@@ -1,148 +1,131 @@
 #include "utils/event_bus_wrapper.hpp"
 
-#include "framework/utils/enum_utils.hpp"
-#include "models/others/events.hpp"
-
-EventBusWrapper::EventBusWrapper() {
+EventBusWrapper::EventBusWrapper() : Loggable("EventBus") {
 }
 
-void EventBusWrapper::onDeviceEvent(Callback&& callback) {
-	this->eventBus.on_without_data(toName(Events::UDEV_CLIENT_DEVICE_EVENT), callback);
+void EventBusWrapper::onDeviceEvent(std::function<void(const std::vector<UsbIdentifier>&, const std::vector<UsbIdentifier>&)>&& callback) {
+	channel<Events::UDEV_CLIENT_DEVICE_EVENT>.on(std::move(callback));
 }
-void EventBusWrapper::emitDeviceEvent() {
-	this->eventBus.emit_event(toName(Events::UDEV_CLIENT_DEVICE_EVENT));
+void EventBusWrapper::emitDeviceEvent(const std::vector<UsbIdentifier>& added, const std::vector<UsbIdentifier>& removed) {
+	// Already debounced by the udev client, every delta is needed
+	post<Events::UDEV_CLIENT_DEVICE_EVENT>(EventPriority::NORMAL, false, added, removed);
 }
 
 void EventBusWrapper::onApplicationShutdown(Callback&& callback) {
-	this->eventBus.on_without_data(toName(Events::APPLICATION_SHUTDOWN), callback);
+	channel<Events::APPLICATION_SHUTDOWN>.on(std::move(callback));
 }
 void EventBusWrapper::emitApplicationShutdown() {
-	this->eventBus.emit_event(toName(Events::APPLICATION_SHUTDOWN));
+	// Pending hardware events must not run against services that are shutting down
+	executor.stop();
+	emit<Events::APPLICATION_SHUTDOWN>();
 }
 
 void EventBusWrapper::onApplicationStop(Callback&& callback) {
-	this->eventBus.on_without_data(toName(Events::APPLICATION_STOP), callback);
+	channel<Events::APPLICATION_STOP>.on(std::move(callback));
 }
 void EventBusWrapper::emitApplicationStop() {
-	this->eventBus.emit_event(toName(Events::APPLICATION_STOP));
+	emit<Events::APPLICATION_STOP>();
 }
 
 void EventBusWrapper::onRgbBrightness(std::function<void(RgbBrightness)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::ORGB_SERVICE_ON_BRIGHTNESS), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<RgbBrightness>(data[0]));
-	});
+	channel<Events::ORGB_SERVICE_ON_BRIGHTNESS>.on(std::move(callback));
 }
 void EventBusWrapper::emitRgbBrightness(const RgbBrightness& brightness) {
-	this->eventBus.emit_event(toName(Events::ORGB_SERVICE_ON_BRIGHTNESS), {brightness});
+	emit<Events::ORGB_SERVICE_ON_BRIGHTNESS>(brightness);
 }
 
-void EventBusWrapper::onRgbColor(std::function<void(std::optional<std::string>)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::ORGB_SERVICE_ON_COLOR), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<std::optional<std::string>>(data[0]));
-	});
+void EventBusWrapper::onRgbColor(std::function<void(const std::optional<std::string>&)>&& callback) {
+	channel<Events::ORGB_SERVICE_ON_COLOR>.on(std::move(callback));
 }
-void EventBusWrapper::emitRgbColor(std::optional<std::string> color) {
-	this->eventBus.emit_event(toName(Events::ORGB_SERVICE_ON_COLOR), {color});
+void EventBusWrapper::emitRgbColor(const std::optional<std::string>& color) {
+	emit<Events::ORGB_SERVICE_ON_COLOR>(color);
 }
 
 #ifdef BAT_LIMIT
 void EventBusWrapper::onChargeThreshold(std::function<void(BatteryThreshold)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::HARDWARE_SERVICE_THRESHOLD_CHANGED), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<BatteryThreshold>(data[0]));
-	});
+	channel<Events::HARDWARE_SERVICE_THRESHOLD_CHANGED>.on(std::move(callback));
 }
 void EventBusWrapper::emitChargeThreshold(const BatteryThreshold& threshold) {
-	this->eventBus.emit_event(toName(Events::HARDWARE_SERVICE_THRESHOLD_CHANGED), {threshold});
+	emit<Events::HARDWARE_SERVICE_THRESHOLD_CHANGED>(threshold);
 }
 #endif
 
-void EventBusWrapper::onRgbEffect(std::function<void(std::string)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::ORGB_SERVICE_ON_EFFECT), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<std::string>(data[0]));
-	});
+void EventBusWrapper::onRgbEffect(std::function<void(const std::string&)>&& callback) {
+	channel<Events::ORGB_SERVICE_ON_EFFECT>.on(std::move(callback));
 }
 void EventBusWrapper::emitRgbEffect(const std::string& effect) {
-	this->eventBus.emit_event(toName(Events::ORGB_SERVICE_ON_EFFECT), {effect});
+	emit<Events::ORGB_SERVICE_ON_EFFECT>(effect);
 }
 
 void EventBusWrapper::onPerformanceProfile(std::function<void(PerformanceProfile)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::PROFILE_SERVICE_ON_PROFILE), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<PerformanceProfile>(data[0]));
-	});
+	channel<Events::PROFILE_SERVICE_ON_PROFILE>.on(std::move(callback));
 }
 void EventBusWrapper::emitPerformanceProfile(const PerformanceProfile& profile) {
-	this->eventBus.emit_event(toName(Events::PROFILE_SERVICE_ON_PROFILE), {profile});
+	emit<Events::PROFILE_SERVICE_ON_PROFILE>(profile);
+}
+
+void EventBusWrapper::onActualPerformanceProfile(std::function<void(PerformanceProfile)>&& callback) {
+	channel<Events::PROFILE_SERVICE_ON_ACTUAL_PROFILE>.on(std::move(callback));
+}
+void EventBusWrapper::emitActualPerformanceProfile(const PerformanceProfile& profile) {
+	emit<Events::PROFILE_SERVICE_ON_ACTUAL_PROFILE>(profile);
 }
 
 void EventBusWrapper::onGameEvent(std::function<void(size_t)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::STEAM_SERVICE_GAME_EVENT), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<size_t>(data[0]));
-	});
+	channel<Events::STEAM_SERVICE_GAME_EVENT>.on(std::move(callback));
 }
 void EventBusWrapper::emitGameEvent(const size_t& runningGames) {
-	this->eventBus.emit_event(toName(Events::STEAM_SERVICE_GAME_EVENT), {runningGames});
+	post<Events::STEAM_SERVICE_GAME_EVENT>(EventPriority::NORMAL, true, runningGames);
 }
 
 void EventBusWrapper::onUsbAdded(Callback&& callback) {
-	this->eventBus.on_without_data(toName(Events::HARDWARE_SERVICE_USB_ADDED), callback);
+	channel<Events::HARDWARE_SERVICE_USB_ADDED>.on(std::move(callback));
 }
 void EventBusWrapper::emitUsbAdded() {
-	this->eventBus.emit_event(toName(Events::HARDWARE_SERVICE_USB_ADDED));
+	post<Events::HARDWARE_SERVICE_USB_ADDED>(EventPriority::NORMAL, true);
 }
 
-void EventBusWrapper::onUsbRemoved(std::function<void(std::vector<UsbIdentifier>)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::PROFILE_SERVICE_ON_PROFILE), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<std::vector<UsbIdentifier>>(data[0]));
-	});
+void EventBusWrapper::onUsbRemoved(std::function<void(const std::vector<UsbIdentifier>&)>&& callback) {
+	channel<Events::HARDWARE_SERVICE_USB_REMOVED>.on(std::move(callback));
 }
 void EventBusWrapper::emitUsbRemoved(const std::vector<UsbIdentifier>& devices) {
-	this->eventBus.emit_event(toName(Events::HARDWARE_SERVICE_USB_REMOVED), {devices});
+	post<Events::HARDWARE_SERVICE_USB_REMOVED>(EventPriority::NORMAL, false, devices);
 }
 
 void EventBusWrapper::onBattery(std::function<void(bool)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::HARDWARE_SERVICE_ON_BATTERY), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<bool>(data[0]));
-	});
+	channel<Events::HARDWARE_SERVICE_ON_BATTERY>.on(std::move(callback));
 }
 void EventBusWrapper::emitBattery(bool onBat) {
-	this->eventBus.emit_event(toName(Events::HARDWARE_SERVICE_ON_BATTERY), {onBat});
+	post<Events::HARDWARE_SERVICE_ON_BATTERY>(EventPriority::HIGH, true, onBat);
 }
 
 void EventBusWrapper::onBatteryStatus(std::function<void(bool)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::BATTERY_STATUS), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<bool>(data[0]));
-	});
+	channel<Events::BATTERY_STATUS>.on(std::move(callback));
 }
 void EventBusWrapper::emitBatteryStatus(bool onBat) {
-	this->eventBus.emit_event(toName(Events::BATTERY_STATUS), {onBat});
+	post<Events::BATTERY_STATUS>(EventPriority::HIGH, true, onBat);
 }
 
-void EventBusWrapper::onScheduler(std::function<void(std::optional<std::string>)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::PROFILE_SERVICE_ON_SCHEDULER), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<std::optional<std::string>>(data[0]));
-	});
+void EventBusWrapper::onScheduler(std::function<void(const std::optional<std::string>&)>&& callback) {
+	channel<Events::PROFILE_SERVICE_ON_SCHEDULER>.on(std::move(callback));
 }
-void EventBusWrapper::emitScheduler(std::optional<std::string> scheduler) {
-	this->eventBus.emit_event(toName(Events::PROFILE_SERVICE_ON_SCHEDULER), {scheduler});
+void EventBusWrapper::emitScheduler(const std::optional<std::string>& scheduler) {
+	emit<Events::PROFILE_SERVICE_ON_SCHEDULER>(scheduler);
 }
 
-void EventBusWrapper::onSsdScheduler(std::function<void(std::string)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::PROFILE_SERVICE_ON_SSD_SCHEDULER), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<std::string>(data[0]));
-	});
+void EventBusWrapper::onSsdScheduler(std::function<void(const std::string&)>&& callback) {
+	channel<Events::PROFILE_SERVICE_ON_SSD_SCHEDULER>.on(std::move(callback));
 }
-void EventBusWrapper::emitSsdScheduler(std::string scheduler) {
-	this->eventBus.emit_event(toName(Events::PROFILE_SERVICE_ON_SSD_SCHEDULER), {scheduler});
+void EventBusWrapper::emitSsdScheduler(const std::string& scheduler) {
+	emit<Events::PROFILE_SERVICE_ON_SSD_SCHEDULER>(scheduler);
 }
 
 #ifdef BOOT_SOUND
 void EventBusWrapper::onBootSound(std::function<void(bool)>&& callback) {
-	this->eventBus.on_with_data(toName(Events::HARDWARE_SERVICE_BOOT_SOUND_CHANGED), [cb = std::move(callback)](CallbackParam data) {
-		cb(std::any_cast<bool>(data[0]));
-	});
+	channel<Events::HARDWARE_SERVICE_BOOT_SOUND_CHANGED>.on(std::move(callback));
 }
 void EventBusWrapper::emitBootSound(bool value) {
-	this->eventBus.emit_event(toName(Events::HARDWARE_SERVICE_BOOT_SOUND_CHANGED), {value});
+	emit<Events::HARDWARE_SERVICE_BOOT_SOUND_CHANGED>(value);
 }
 #endif
 
@@ -36,7 +36,7 @@ git submodule update --init --recursive
 echo "Compiling and running application..."
 cd "$DEV_FOLDER"
 
-RCC_LOG_LEVEL=DEBUG make run
+RCC_LOG_LEVEL=DEBUG RCC_TRACE=1 make run
 EXIT_CODE=$?
 
 echo ""